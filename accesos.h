@@ -0,0 +1,362 @@
+#ifndef ACCESOS_H
+#define ACCESOS_H
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <memory>
+#include <vector>
+#include <span>
+#include <string_view>
+#include <cstring>
+#include <ctime>
+#include "perfiles.h"
+#include "metricas.h"
+#include "seguridad.h"
+#include "bocetos.h"
+#include "acumulados.h"
+#include "columnas.h"
+#include "tabla_hash.h"
+using namespace std;
+
+// convierte una cadena a minúsculas
+inline string toLowerCase(const string& str) {
+    string lowerStr = str; // copia de la cadena original
+    for (char& c : lowerStr) {
+        c = tolower(c); // convierte cada carácter a minúscula
+    }
+    return lowerStr; // devuelve la cadena en minúsculas
+}
+
+// -----GESTION DE ACCESOS-----
+// cadena corta guardada dentro del propio objeto, sin memoria dinamica. Si el valor no
+// cabe en la capacidad, los bytes en linea guardan un puntero a un bloque aparte con la
+// longitud y los caracteres, asi que ningun valor se rechaza y solo los largos reservan
+template <size_t Capacidad>
+class CadenaFija {
+private:
+    static constexpr unsigned char fueraDeLinea = 255; // longitud que indica un bloque aparte
+
+    char datos[Capacidad]; // caracteres de la cadena, sin terminador, o el puntero al bloque
+    unsigned char longitud = 0; // numero de caracteres usados, o fueraDeLinea
+
+    static_assert(Capacidad >= sizeof(char*) && Capacidad < fueraDeLinea, "la longitud se guarda en un byte y los datos alojan un puntero");
+
+    char* bloque() const {
+        char* puntero;
+        memcpy(&puntero, datos, sizeof(puntero));
+        return puntero;
+    }
+
+    void liberar() {
+        if (longitud == fueraDeLinea) delete[] bloque();
+        longitud = 0;
+    }
+
+public:
+    static constexpr size_t capacidad = Capacidad; // caracteres que caben en linea
+
+    CadenaFija() = default;
+
+    CadenaFija(const CadenaFija& otra) {
+        asignar(otra.vista());
+    }
+
+    CadenaFija& operator=(const CadenaFija& otra) {
+        if (this != &otra) asignar(otra.vista());
+        return *this;
+    }
+
+    ~CadenaFija() {
+        liberar();
+    }
+
+    // asigna un valor; los que no caben en linea se copian a un bloque aparte. Se copia
+    // antes de liberar lo anterior, por si valor apunta a esta misma cadena
+    void asignar(string_view valor) {
+        if (valor.size() <= Capacidad) {
+            char copia[Capacidad];
+            memcpy(copia, valor.data(), valor.size());
+            liberar();
+            memcpy(datos, copia, valor.size());
+            longitud = static_cast<unsigned char>(valor.size());
+            return;
+        }
+        size_t tam = valor.size();
+        char* nuevo = new char[sizeof(tam) + tam];
+        memcpy(nuevo, &tam, sizeof(tam));
+        memcpy(nuevo + sizeof(tam), valor.data(), tam);
+        liberar();
+        memcpy(datos, &nuevo, sizeof(nuevo));
+        longitud = fueraDeLinea;
+    }
+
+    // indica si el valor vive en un bloque aparte
+    bool enBloque() const {
+        return longitud == fueraDeLinea;
+    }
+
+    string_view vista() const {
+        if (longitud != fueraDeLinea) return string_view(datos, longitud);
+        size_t tam;
+        memcpy(&tam, bloque(), sizeof(tam));
+        return string_view(bloque() + sizeof(tam), tam);
+    }
+
+    bool empty() const {
+        return longitud == 0;
+    }
+
+    bool operator==(string_view otra) const {
+        return vista() == otra;
+    }
+
+    friend ostream& operator<<(ostream& os, const CadenaFija& cadena) {
+        return os << cadena.vista();
+    }
+};
+
+// capacidades en linea de los campos de credenciales; los valores mas largos se guardan aparte
+constexpr size_t maxContrasena = 23; // caracteres de la contraseña
+constexpr size_t maxTelefono = 15; // digitos de un telefono E.164
+
+// clase NodoAcceso representa un nodo en la lista de accesos; las credenciales cortas se
+// guardan en linea para que crear un registro no reserve memoria adicional
+class NodoAcceso {
+public:
+    string nombreUsuario; // nombre del usuario
+    time_t horaAcceso; // hora de acceso
+    NodoAcceso* siguiente; // puntero al siguiente nodo
+    int perfil; // perfil del usuario (1: usuario, 2: supervisor, 3: analista)
+    CadenaFija<maxTelefono> telefono; // teléfono del usuario
+    CadenaFija<maxContrasena> contrasena; // contraseña del usuario
+
+    // constructor para inicializar los atributos del nodo; solo las credenciales mas
+    // largas que la capacidad en linea reservan memoria
+    NodoAcceso(const string& nombre, time_t hora, int p, string_view pass = "", string_view phone = "")
+        : nombreUsuario(nombre), horaAcceso(hora), siguiente(nullptr), perfil(p) {
+        contrasena.asignar(pass);
+        telefono.asignar(phone);
+    }
+};
+
+// clase ListaEnlazadaAccesos gestiona una lista enlazada de accesos
+// como lleva la lista las estadisticas de accesos por usuario
+enum class ModoEstadisticas : unsigned char {
+    Exacto, // un contador por usuario distinto
+    Aproximado // memoria fija: usuarios mas activos y frecuencias estimadas
+};
+
+// identificador distinto para cada lista, tambien entre ejecuciones
+inline uint64_t nuevoIdentificadorLista() {
+    static atomic<uint64_t> creadas{0};
+    return static_cast<uint64_t>(chrono::system_clock::now().time_since_epoch().count()) + creadas++;
+}
+
+class ListaEnlazadaAccesos {
+private:
+    NodoAcceso* cabeza; // puntero al primer nodo de la lista
+    uint64_t identificador = nuevoIdentificadorLista(); // valida las posiciones de columna guardadas fuera de la lista
+    TablaHashPlana<string, int> conteos; // accesos por usuario, actualizados en cada insercion (modo exacto)
+    unique_ptr<EstadisticasAproximadas> aproximadas; // bocetos de accesos (modo aproximado), o nullptr
+    DistintosPorPeriodo distintos; // usuarios distintos por hora y por dia
+    uint64_t totalAccesos = 0; // accesos insertados
+    AcumuladosAccesos acumulados; // accesos por perfil y minuto, hora y dia
+    vector<time_t> columnaHoras; // hora de cada acceso en orden de insercion, contigua para las busquedas por tiempo
+    vector<NodoAcceso*> columnaNodos; // nodo de cada posicion de columnaHoras
+
+    // inserta un nodo en orden cronológico usando recursión
+    void insertarRecursivo(NodoAcceso*& actual, NodoAcceso* nuevo) {
+        if (!actual || difftime(nuevo->horaAcceso, actual->horaAcceso) < 0) { // si la lista está vacía o el nuevo nodo es más antiguo
+            nuevo->siguiente = actual; // enlaza el nuevo nodo al inicio
+            actual = nuevo; // actualiza la cabeza de la lista
+            return;
+        }
+        insertarRecursivo(actual->siguiente, nuevo); // continúa con el siguiente nodo
+    }
+
+    // busca un nodo por nombre o por hora usando recursión
+    NodoAcceso* buscarRecursivo(NodoAcceso* actual, const string& usuario, time_t hora, bool buscarPorUsuario) {
+        if (!actual) { // si no hay más nodos
+            cout << "Error: No se encontro el registro correspondiente." << endl; // mensaje de error
+            return nullptr; // devuelve un puntero nulo
+        }
+        if (buscarPorUsuario && toLowerCase(actual->nombreUsuario) == toLowerCase(usuario)) { // compara nombres en minúsculas
+            return actual; // devuelve el nodo encontrado
+        } else if (!buscarPorUsuario && difftime(actual->horaAcceso, hora) == 0) { // compara por hora
+            return actual; // devuelve el nodo encontrado
+        }
+        return buscarRecursivo(actual->siguiente, usuario, hora, buscarPorUsuario); // recursión para buscar en el siguiente nodo
+    }
+
+    // muestra los nodos de la lista usando recursión
+    void mostrarRecursivo(NodoAcceso* actual) {
+        if (!actual) return; // si no hay más nodos, detiene la recursión
+        cout << "Usuario: " << actual->nombreUsuario
+             << ", Hora: " << ctime(&(actual->horaAcceso))
+             << ", Perfil: " << actual->perfil << endl; // muestra los detalles del nodo
+        mostrarRecursivo(actual->siguiente); // muestra el siguiente nodo
+    }
+
+public:
+    // inicializa una lista vacía
+    explicit ListaEnlazadaAccesos(ModoEstadisticas modo = ModoEstadisticas::Exacto) : cabeza(nullptr) {
+        if (modo == ModoEstadisticas::Aproximado) aproximadas = make_unique<EstadisticasAproximadas>();
+    }
+
+    ~ListaEnlazadaAccesos() {
+        while (cabeza) { // mientras haya nodos en la lista
+            NodoAcceso* temp = cabeza; // almacena el nodo actual
+            cabeza = cabeza->siguiente; // pasa al siguiente nodo
+            delete temp; // elimina el nodo actual
+        }
+    }
+    // devuelve el puntero a la cabeza de la lista
+    NodoAcceso* getCabeza() const {
+        return cabeza;
+    }
+
+    // numero de accesos de cada usuario, sin orden; vacio en modo aproximado
+    const TablaHashPlana<string, int>& getConteos() const {
+        return conteos;
+    }
+
+    // usuarios distintos por periodo, para estimar los de cualquier ventana
+    const DistintosPorPeriodo& getDistintos() const {
+        return distintos;
+    }
+
+    // accesos agregados por periodo y perfil, para consultas sin recorrer la lista
+    const AcumuladosAccesos& getAcumulados() const {
+        return acumulados;
+    }
+
+    uint64_t getTotalAccesos() const {
+        return totalAccesos;
+    }
+
+    // identifica esta lista; una posicion de la columna guardada con otro identificador no
+    // corresponde a estos accesos
+    uint64_t getIdentificador() const {
+        return identificador;
+    }
+
+    // estadisticas aproximadas, o nullptr en modo exacto
+    const EstadisticasAproximadas* getAproximadas() const {
+        return aproximadas.get();
+    }
+
+    // inserta un nodo en la lista
+    void insertar(const string& nombre, time_t hora, int perfil, const string& pass = "", const string& phone = "") {
+        NodoAcceso* nuevo = new NodoAcceso(nombre, hora, perfil, pass, phone); // crea un nuevo nodo
+        insertarRecursivo(cabeza, nuevo); // llama a la función recursiva para insertar el nodo
+        columnaHoras.push_back(hora);
+        columnaNodos.push_back(nuevo);
+        distintos.registrar(nuevo->nombreUsuario, hora);
+        acumulados.registrar(perfil, hora);
+        ++totalAccesos;
+        if (aproximadas) aproximadas->registrar(nuevo->nombreUsuario); // memoria fija sin importar los usuarios
+        else conteos[nuevo->nombreUsuario]++; // mantiene las estadisticas sin volver a recorrer la lista
+    }
+
+    // busca un nodo por nombre
+    NodoAcceso* buscarPorNombre(const string& usuario) {
+        return buscarRecursivo(cabeza, usuario, 0, true); // llama a la función recursiva para buscar por nombre
+    }
+
+    // busca un nodo por hora sobre la columna de horas; entre accesos con la misma hora
+    // devuelve el primero insertado, que es tambien el primero de la lista
+    NodoAcceso* buscarPorHora(time_t hora) {
+        size_t posicion = primeroEnRango(columnaHoras, hora, hora + 1);
+        if (posicion == columnaHoras.size()) {
+            cout << "Error: No se encontro el registro correspondiente." << endl; // mensaje de error
+            return nullptr;
+        }
+        return columnaNodos[posicion];
+    }
+
+    // columna con la hora de cada acceso, en orden de insercion
+    span<const time_t> getColumnaHoras() const {
+        return columnaHoras;
+    }
+
+    // cuenta los accesos con hora en [desde, hasta)
+    size_t contarEnVentana(time_t desde, time_t hasta) const {
+        return contarEnRango(columnaHoras, desde, hasta);
+    }
+
+    // llama a visitar(nodo) para cada acceso con hora en [desde, hasta), en orden de
+    // insercion. Filtra la columna por bloques de filasPorBloqueFiltro con un buffer de
+    // seleccion fijo en la pila: la memoria no depende del tamaño de la columna, y las
+    // posiciones de 32 bits son relativas al bloque, asi que no limitan el numero de filas
+    template <typename Visitar>
+    void recorrerPorHora(time_t desde, time_t hasta, Visitar visitar) const {
+        static constexpr size_t filasPorBloqueFiltro = 4096;
+        uint32_t seleccion[filasPorBloqueFiltro];
+        span<const time_t> columna = columnaHoras;
+        for (size_t base = 0; base < columna.size(); base += filasPorBloqueFiltro) {
+            span<const time_t> bloque = columna.subspan(base, min(filasPorBloqueFiltro, columna.size() - base));
+            size_t seleccionadas = filtrarEnRango(bloque, desde, hasta, seleccion);
+            for (size_t i = 0; i < seleccionadas; ++i) visitar(columnaNodos[base + seleccion[i]]);
+        }
+    }
+
+    // llama a visitar(nodo) para los accesos desde la posicion indicada de la columna, es
+    // decir, los insertados despues de que la columna tuviera ese tamaño
+    template <typename Visitar>
+    void recorrerDesde(size_t posicion, Visitar visitar) const {
+        for (size_t i = posicion; i < columnaNodos.size(); ++i) visitar(columnaNodos[i]);
+    }
+
+    // nodos de los accesos con hora en [desde, hasta), en orden de insercion
+    vector<NodoAcceso*> filtrarPorHora(time_t desde, time_t hasta) const {
+        vector<NodoAcceso*> nodos;
+        recorrerPorHora(desde, hasta, [&](NodoAcceso* nodo) { nodos.push_back(nodo); });
+        return nodos;
+    }
+
+    // primera y ultima hora registradas; {0, 0} si la lista esta vacia
+    pair<time_t, time_t> rangoHoras() const {
+        return columnaHoras.empty() ? pair<time_t, time_t>{0, 0} : minimoMaximo(columnaHoras);
+    }
+
+
+    // valida las credenciales de un usuario
+    bool validarCredenciales(const string& usuario, const string& contrasena = "", const string& telefono = "", const string& contrasenaAleatoria = "") {
+        NodoAcceso* nodo = medirFase(FaseLogin::Busqueda, [&] { return buscarPorNombre(usuario); }); // busca al usuario por nombre
+        if (!nodo) { // si no encuentra el nodo
+            cout << "Error: Usuario no registrado." << endl; // mensaje de error
+            return false;
+        }
+        const DescriptorPerfil* perfil = buscarPerfil(nodo->perfil); // factores exigidos por el perfil
+        if (!perfil) {
+            cout << "Error: Perfil no reconocido." << endl; // mensaje de error
+            return false;
+        }
+        // evalua todos los factores sin saltos y solo ramifica para informar del primer fallo
+        auto [falloContrasena, falloTelefono] = medirFase(FaseLogin::Credenciales, [&] {
+            return pair<bool, bool>{perfil->requiereContrasena & (nodo->contrasena != contrasena),
+                                    perfil->requiereTelefono & (nodo->telefono != telefono)};
+        });
+        bool falloDiaria = medirFase(FaseLogin::ContrasenaDiaria, [&] {
+            return perfil->requiereContrasenaDiaria & !contrasenaAleatoria.empty()
+                   && contrasenaAleatoria != generarContrasenaDiaria(); // la contraseña diaria es opcional
+        });
+        if (falloContrasena | falloTelefono | falloDiaria) {
+            if (falloContrasena) cout << "Error: Contrasenia incorrecta." << endl; // mensaje de error
+            else if (falloTelefono) cout << "Error: Telefono incorrecto." << endl; // mensaje de error
+            else cout << "Error: Contrasenia aleatoria incorrecta." << endl; // mensaje de error
+            return false;
+        }
+        cout << "Credenciales validas para el usuario " << usuario << "." << endl; // mensaje de éxito
+        return true; // devuelve verdadero si las credenciales son válidas
+    }
+
+    // muestra todos los nodos de la lista
+    void mostrar() {
+        mostrarRecursivo(cabeza); // llama a la función recursiva para mostrar los nodos
+    }
+};
+
+#endif //ACCESOS_H
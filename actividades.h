@@ -0,0 +1,520 @@
+#ifndef ACTIVIDADES_H
+#define ACTIVIDADES_H
+
+#include <iostream>
+#include <string>
+#include <ctime>
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <span>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+#include "accesos.h"
+#include "internado.h"
+#include "catalogo.h"
+#include "temporizadores.h"
+#include "diario.h"
+#include "metricas.h"
+#include "deteccion.h"
+#include "tabla_hash.h"
+using namespace std;
+
+// -------ACTIVIDADES-------
+// registro de tamaño fijo de una actividad; usuario y actividad son ids de
+// tablaUsuarios y catalogoActividades
+struct RegistroActividad {
+    uint32_t usuario; // usuario al que pertenece la actividad
+    uint32_t actividad; // descripcion de la actividad
+    time_t hora; // hora en que se asigna la actividad
+    uint64_t siguienteUsuario; // secuencia de la siguiente actividad del mismo usuario
+    uint32_t temporizador; // plazo de la actividad en la rueda, o sinTemporizador si no tiene
+    bool vencida; // el plazo de la actividad ya vencio
+
+    static constexpr uint64_t sinSiguiente = UINT64_MAX; // fin de la cadena del usuario
+
+    const string& getUsuario() const {
+        return tablaUsuarios.valor(usuario);
+    }
+
+    const string& getActividad() const {
+        return catalogoActividades.descripcion(actividad);
+    }
+};
+
+// cadena de actividades pendientes de un usuario, enlazada por numero de secuencia
+struct CadenaUsuario {
+    uint64_t primero = RegistroActividad::sinSiguiente; // actividad mas antigua del usuario
+    uint64_t ultimo = RegistroActividad::sinSiguiente; // actividad mas reciente del usuario
+    int pendientes = 0; // numero de actividades en la cadena
+};
+
+// actividad a encolar dentro de un lote
+struct SolicitudActividad {
+    string usuario; // usuario al que se asigna
+    uint32_t actividad; // id de la actividad en catalogoActividades
+    time_t vencimiento = 0; // plazo opcional (0 sin plazo)
+};
+
+// que hacer cuando una cola limitada esta llena
+enum class PoliticaDesborde : unsigned char { Bloquear, Rechazar, DescartarAntigua };
+
+// nombre de cada politica, indexado por PoliticaDesborde
+constexpr array<const char*, 3> nombresPoliticaDesborde = {"bloquear", "rechazar", "descartar_antigua"};
+
+// limite de capacidad de una cola; capacidad 0 significa sin limite
+struct LimiteCola {
+    size_t capacidad = 0; // maximo de actividades pendientes
+    PoliticaDesborde politica = PoliticaDesborde::Rechazar; // que hacer al llegar al maximo
+    chrono::milliseconds esperaMaxima{1000}; // con Bloquear, espera antes de rechazar
+};
+
+// resultado de intentar encolar una actividad; NoDurable indica que la actividad quedo en
+// la cola pero el diario no pudo guardarla, asi que se perderia al reiniciar
+enum class ResultadoEncolado : unsigned char { Encolada, Duplicada, Rechazada, NoDurable };
+
+// resultado de encolar un lote; las aceptadas quedan en la cola aunque durable sea false,
+// que indica que el diario no pudo guardarlas y se perderian al reiniciar
+struct ResultadoLote {
+    size_t aceptadas = 0; // actividades que entraron en la cola
+    bool durable = true; // false si en modo durable el diario no pudo guardar el lote
+};
+
+// cola para gestionar actividades sobre un buffer circular que crece al doble cuando se
+// llena; en regimen estable enqueue y dequeue no reservan memoria. Cada registro tiene
+// un numero de secuencia creciente que no cambia al crecer el buffer. Las operaciones
+// publicas toman el cerrojo de la cola; las operaciones por lotes lo toman una sola vez.
+// getFrente y en devuelven referencias internas y no deben usarse con escritores concurrentes
+class ColaActividades {
+private:
+    vector<RegistroActividad> buffer; // registros; su tamaño es siempre potencia de dos
+    size_t inicio = 0; // posicion del frente en el buffer
+    size_t cantidad = 0; // registros en la cola
+    uint64_t secuenciaFrente = 0; // secuencia del registro del frente
+    vector<CadenaUsuario> cadenas; // cadena de actividades por id de usuario
+    TablaHashPlana<uint64_t, uint32_t> paresPendientes; // veces que cada par (usuario, actividad) esta en la cola
+    RuedaTemporizadores plazos; // plazos de las actividades, identificadas por su secuencia
+    mutable mutex cerrojo; // protege todo el estado de la cola
+    condition_variable espacioLibre; // avisa a los productores bloqueados cuando se extrae
+    LimiteCola limite; // capacidad y politica de desborde
+    MetricasCola metricas; // profundidad, ritmo y esperas de la cola
+    DetectorSospechosas* detector = nullptr; // recibe cada actividad encolada, si se indica
+    unique_ptr<DiarioActividades> diario; // diario del modo durable, o nullptr
+
+    // posicion en el buffer de un numero de secuencia presente en la cola
+    size_t posicion(uint64_t secuencia) const {
+        return (inicio + (secuencia - secuenciaFrente)) & (buffer.size() - 1);
+    }
+
+    // duplica la capacidad copiando los registros en orden al principio del nuevo buffer
+    void crecer() {
+        vector<RegistroActividad> nuevo(buffer.empty() ? 16 : buffer.size() * 2);
+        for (size_t i = 0; i < cantidad; ++i) {
+            nuevo[i] = buffer[(inicio + i) & (buffer.size() - 1)];
+        }
+        buffer.swap(nuevo);
+        inicio = 0;
+    }
+
+    // clave compacta de un par (usuario, actividad)
+    static uint64_t clavePar(uint32_t idUsuario, uint32_t idActividad) {
+        return (static_cast<uint64_t>(idUsuario) << 32) | idActividad;
+    }
+
+    // indica si el par esta pendiente; requiere el cerrojo
+    bool parPendiente(uint32_t idUsuario, uint32_t idActividad) const {
+        return paresPendientes.contiene(clavePar(idUsuario, idActividad));
+    }
+
+    // agrega un registro al final; requiere el cerrojo y espacio libre en el buffer
+    void encolar(uint32_t idUsuario, uint32_t idActividad, time_t vencimiento, time_t ahora) {
+        uint64_t secuencia = secuenciaFrente + cantidad;
+        uint32_t temporizador = vencimiento ? plazos.programar(vencimiento, secuencia, ahora) : RuedaTemporizadores::sinTemporizador;
+        buffer[posicion(secuencia)] = {idUsuario, idActividad, ahora,
+                                       RegistroActividad::sinSiguiente, temporizador, false};
+        ++cantidad;
+
+        if (idUsuario >= cadenas.size()) cadenas.resize(idUsuario + 1);
+        CadenaUsuario& cadena = cadenas[idUsuario]; // enlaza el registro al final de la cadena del usuario
+        if (cadena.pendientes) {
+            buffer[posicion(cadena.ultimo)].siguienteUsuario = secuencia;
+        } else {
+            cadena.primero = secuencia;
+        }
+        cadena.ultimo = secuencia;
+        cadena.pendientes++;
+        paresPendientes[clavePar(idUsuario, idActividad)]++;
+    }
+
+    // elimina el registro del frente; requiere el cerrojo y una cola no vacia
+    void desencolar() {
+        // el registro mas antiguo de la cola es tambien el primero de la cadena de su usuario
+        const RegistroActividad& frente = buffer[inicio];
+        if (frente.temporizador != RuedaTemporizadores::sinTemporizador) plazos.cancelar(frente.temporizador); // ya no tiene plazo pendiente
+        CadenaUsuario& cadena = cadenas[frente.usuario];
+        cadena.primero = frente.siguienteUsuario;
+        cadena.pendientes--;
+        uint64_t par = clavePar(frente.usuario, frente.actividad);
+        if (--*paresPendientes.buscar(par) == 0) paresPendientes.borrar(par);
+
+        inicio = (inicio + 1) & (buffer.size() - 1); // avanza el frente
+        --cantidad;
+        ++secuenciaFrente;
+    }
+
+    // hace sitio para un registro nuevo segun el limite de la cola; requiere el cerrojo,
+    // que Bloquear suelta mientras espera. Devuelve false si la actividad se rechaza
+    bool reservar(unique_lock<mutex>& bloqueo) {
+        if (limite.capacidad && cantidad >= limite.capacidad) {
+            switch (limite.politica) {
+                case PoliticaDesborde::Rechazar:
+                    metricas.anotarRechazo();
+                    return false;
+                case PoliticaDesborde::DescartarAntigua: {
+                    uint64_t descartadas = 0;
+                    for (; cantidad >= limite.capacidad; ++descartadas) desencolar();
+                    metricas.anotarDescartes(descartadas);
+                    anotarDesencolado(descartadas); // el descarte queda en el diario antes que el nuevo registro
+                    break;
+                }
+                case PoliticaDesborde::Bloquear: {
+                    auto inicioEspera = chrono::steady_clock::now();
+                    bool hayEspacio = espacioLibre.wait_for(bloqueo, limite.esperaMaxima,
+                                                            [&] { return !limite.capacidad || cantidad < limite.capacidad; });
+                    metricas.registrarBloqueo(inicioEspera);
+                    if (!hayEspacio) {
+                        metricas.anotarRechazo();
+                        return false;
+                    }
+                    break;
+                }
+            }
+        }
+        if (cantidad == buffer.size()) crecer();
+        return true;
+    }
+
+    // encola una actividad de un usuario ya normalizado, respetando el limite y, si unico,
+    // rechazando los pares que ya estan pendientes
+    ResultadoEncolado agregar(uint32_t idUsuario, uint32_t idActividad, time_t vencimiento, bool unico) {
+        uint64_t lsn;
+        {
+            unique_lock bloqueo(cerrojo);
+            if (unico && parPendiente(idUsuario, idActividad)) return ResultadoEncolado::Duplicada;
+            if (!reservar(bloqueo)) return ResultadoEncolado::Rechazada;
+            if (unico && parPendiente(idUsuario, idActividad)) return ResultadoEncolado::Duplicada; // pudo llegar mientras esperaba
+            time_t ahora = time(0);
+            encolar(idUsuario, idActividad, vencimiento, ahora);
+            metricas.anotarEncolado(cantidad);
+            if (detector) detector->registrar(idUsuario, idActividad, ahora);
+            lsn = anotarEncolado(en(cantidad - 1));
+        }
+        return confirmar(lsn) ? ResultadoEncolado::Encolada : ResultadoEncolado::NoDurable;
+    }
+
+    // anota en el diario el registro recien encolado; requiere el cerrojo. Devuelve su lsn
+    // o 0 si la cola no es durable
+    uint64_t anotarEncolado(const RegistroActividad& registro) {
+        if (!diario) return 0;
+        time_t vencimiento = registro.temporizador != RuedaTemporizadores::sinTemporizador ? plazos.vencimiento(registro.temporizador) : 0;
+        uint64_t lsn = diario->registrarEncolado(registro.getUsuario(), registro.getActividad(), registro.hora, vencimiento);
+        if (diario->necesitaPuntoControl()) puntoControl(); // el diario crecio demasiado
+        return lsn;
+    }
+
+    // anota en el diario que se eliminaron registros del frente; requiere el cerrojo
+    uint64_t anotarDesencolado(uint64_t eliminados) {
+        if (!diario || !eliminados) return 0;
+        uint64_t lsn = diario->registrarDesencolado(eliminados);
+        if (diario->necesitaPuntoControl()) puntoControl(); // el diario crecio demasiado
+        return lsn;
+    }
+
+    // escribe un punto de control con el contenido actual; requiere el cerrojo
+    bool puntoControl() {
+        return diario->puntoControl([&](auto visitar) {
+            for (size_t i = 0; i < cantidad; ++i) {
+                const RegistroActividad& registro = buffer[(inicio + i) & (buffer.size() - 1)];
+                time_t vencimiento = registro.temporizador != RuedaTemporizadores::sinTemporizador ? plazos.vencimiento(registro.temporizador) : 0;
+                visitar(registro.getUsuario(), registro.getActividad(), registro.hora, vencimiento);
+            }
+        });
+    }
+
+    // espera, sin el cerrojo de la cola, a que un registro del diario sea durable. Devuelve
+    // false si el diario fallo
+    bool confirmar(uint64_t lsn) {
+        return !lsn || diario->esperar(lsn); // varias operaciones comparten la misma sincronizacion
+    }
+
+public:
+    ColaActividades() = default; // inicializa una cola vacia
+
+    // activa el modo durable: recupera las actividades del punto de control y del diario
+    // de la configuracion, deja un punto de control limpio y a partir de ahi anota cada
+    // cambio. Devuelve false si no puede abrir el diario o escribir el punto de control; en
+    // ese caso la cola sigue sin diario, con las actividades recuperadas
+    bool activarDurabilidad(const ConfiguracionDiario& configuracion) {
+        lock_guard bloqueo(cerrojo);
+        auto nuevo = make_unique<DiarioActividades>(configuracion);
+        bool abierto = nuevo->recuperar(
+            [&](string_view usuario, string_view actividad, time_t hora, time_t vencimiento) {
+                if (cantidad == buffer.size()) crecer();
+                encolar(tablaUsuarios.internar(usuario), catalogoActividades.internar(actividad), vencimiento, hora);
+            },
+            [&](uint64_t eliminados) {
+                for (; eliminados && cantidad; --eliminados) desencolar();
+            });
+        if (!abierto) return false;
+        diario = std::move(nuevo);
+        if (!puntoControl()) { // descarta registros incompletos y acorta la proxima recuperacion
+            diario.reset(); // no se anota nada en un diario que no se pudo dejar limpio
+            return false;
+        }
+        return true;
+    }
+
+    // indica si la cola esta en modo durable
+    bool esDurable() const {
+        lock_guard bloqueo(cerrojo);
+        return diario != nullptr;
+    }
+
+    // obtiene el registro del frente de la cola o nullptr si esta vacia
+    const RegistroActividad* getFrente() const {
+        return cantidad ? &buffer[inicio] : nullptr;
+    }
+
+    // numero de actividades en la cola
+    size_t tamano() const {
+        lock_guard bloqueo(cerrojo);
+        return cantidad;
+    }
+
+    // devuelve la actividad que ocupa la posicion indicada contando desde el frente
+    const RegistroActividad& en(size_t indice) const {
+        return buffer[(inicio + indice) & (buffer.size() - 1)];
+    }
+
+    // llama a visitar(registro) para cada actividad, del frente al final, con el cerrojo tomado
+    template <typename Visitar>
+    void recorrer(Visitar visitar) const {
+        lock_guard bloqueo(cerrojo);
+        for (size_t i = 0; i < cantidad; ++i) {
+            visitar(buffer[(inicio + i) & (buffer.size() - 1)]);
+        }
+    }
+
+    // llama a visitar(registro) para cada actividad de un usuario, de la mas antigua a la
+    // mas reciente, recorriendo solo su cadena con el cerrojo tomado
+    template <typename Visitar>
+    void recorrerUsuario(const string& usuario, Visitar visitar) const {
+        uint32_t idUsuario = tablaUsuarios.buscar(toLowerCase(usuario));
+        lock_guard bloqueo(cerrojo);
+        if (idUsuario >= cadenas.size()) return;
+        for (uint64_t s = cadenas[idUsuario].primero; s != RegistroActividad::sinSiguiente;) {
+            const RegistroActividad& registro = buffer[posicion(s)];
+            visitar(registro);
+            s = registro.siguienteUsuario;
+        }
+    }
+
+    // limita la capacidad de la cola; no elimina actividades si ya hay mas que la nueva capacidad
+    void limitar(const LimiteCola& nuevo) {
+        {
+            lock_guard bloqueo(cerrojo);
+            limite = nuevo;
+        }
+        espacioLibre.notify_all(); // la nueva capacidad puede dejar pasar a productores bloqueados
+    }
+
+    LimiteCola getLimite() const {
+        lock_guard bloqueo(cerrojo);
+        return limite;
+    }
+
+    // envia cada actividad que se encole a partir de ahora al detector indicado (o a
+    // ninguno con nullptr); las recuperadas del diario no se envian
+    void vigilar(DetectorSospechosas* nuevo) {
+        lock_guard bloqueo(cerrojo);
+        detector = nuevo;
+    }
+
+    // metricas de la cola; pueden leerse sin bloquear a los productores
+    const MetricasCola& getMetricas() const {
+        return metricas;
+    }
+
+    // agrega una actividad a la cola; vencimiento es opcional (0 significa sin plazo).
+    // Devuelve false si la cola esta llena y la politica la rechaza, o si en modo durable
+    // el diario no pudo guardarla
+    bool enqueue(const string& usuario, const string& actividad, time_t vencimiento = 0) {
+        return enqueue(usuario, catalogoActividades.internar(actividad), vencimiento);
+    }
+
+    // agrega una actividad del catalogo a la cola, indicada por su id
+    bool enqueue(const string& usuario, uint32_t idActividad, time_t vencimiento = 0) {
+        uint32_t idUsuario = tablaUsuarios.internar(toLowerCase(usuario)); // Normalizamos el nombre
+        return agregar(idUsuario, idActividad, vencimiento, false) == ResultadoEncolado::Encolada;
+    }
+
+    // agrega la actividad solo si el usuario no la tiene ya pendiente; la comprobacion es
+    // O(1) y permite varias actividades distintas por usuario
+    ResultadoEncolado enqueueUnico(const string& usuario, uint32_t idActividad, time_t vencimiento = 0) {
+        uint32_t idUsuario = tablaUsuarios.internar(toLowerCase(usuario)); // Normalizamos el nombre
+        return agregar(idUsuario, idActividad, vencimiento, true);
+    }
+
+    ResultadoEncolado enqueueUnico(const string& usuario, const string& actividad, time_t vencimiento = 0) {
+        return enqueueUnico(usuario, catalogoActividades.internar(actividad), vencimiento);
+    }
+
+    // indica en O(1) si un usuario tiene pendiente una actividad concreta
+    bool tieneActividad(const string& usuario, const string& actividad) const {
+        return vecesPendiente(usuario, actividad) > 0;
+    }
+
+    // devuelve en O(1) cuantas veces tiene pendiente un usuario una actividad concreta
+    uint32_t vecesPendiente(const string& usuario, const string& actividad) const {
+        uint32_t idUsuario = tablaUsuarios.buscar(toLowerCase(usuario));
+        uint32_t idActividad = catalogoActividades.buscar(actividad);
+        if (idUsuario == TablaInternado::sinId || idActividad == TablaInternado::sinId) return 0;
+        lock_guard bloqueo(cerrojo);
+        const uint32_t* veces = paresPendientes.buscar(clavePar(idUsuario, idActividad));
+        return veces ? *veces : 0;
+    }
+
+    // agrega un lote de actividades con una sola toma del cerrojo, una sola lectura del
+    // reloj y el crecimiento del buffer hecho de una vez. Aplica el limite a cada
+    // actividad y devuelve cuantas se aceptaron y si el diario pudo guardarlas
+    ResultadoLote enqueueLote(span<const SolicitudActividad> lote) {
+        vector<uint32_t> idsUsuario(lote.size()); // se normalizan fuera del cerrojo
+        for (size_t i = 0; i < lote.size(); ++i) {
+            idsUsuario[i] = i && lote[i].usuario == lote[i - 1].usuario
+                                ? idsUsuario[i - 1] // evita internar de nuevo al mismo usuario
+                                : tablaUsuarios.internar(toLowerCase(lote[i].usuario));
+        }
+        time_t ahora = time(0);
+        uint64_t lsn = 0;
+        ResultadoLote resultado;
+        {
+            unique_lock bloqueo(cerrojo);
+            size_t necesarias = cantidad + lote.size();
+            if (limite.capacidad) necesarias = min(necesarias, max(limite.capacidad, cantidad));
+            while (necesarias > buffer.size()) crecer();
+            for (size_t i = 0; i < lote.size(); ++i) {
+                if (!reservar(bloqueo)) continue;
+                encolar(idsUsuario[i], lote[i].actividad, lote[i].vencimiento, ahora);
+                metricas.anotarEncolado(cantidad);
+                if (detector) detector->registrar(idsUsuario[i], lote[i].actividad, ahora);
+                lsn = anotarEncolado(en(cantidad - 1));
+                ++resultado.aceptadas;
+            }
+        }
+        resultado.durable = confirmar(lsn); // el lote entero espera a una sola sincronizacion
+        return resultado;
+    }
+
+    // elimina la actividad mas antigua de la cola
+    void dequeue() {
+        uint64_t lsn;
+        {
+            lock_guard bloqueo(cerrojo);
+            if (!cantidad) { // si la cola esta vacia
+                cout << "No hay actividades para eliminar." << endl; // mensaje de error
+                return;
+            }
+            metricas.registrarPermanencia(time(0) - buffer[inicio].hora);
+            desencolar();
+            lsn = anotarDesencolado(1);
+        }
+        espacioLibre.notify_all(); // despierta a los productores que esperan sitio
+        confirmar(lsn);
+    }
+
+    // extrae hasta maximo actividades del frente llamando a procesar(registro) antes de
+    // eliminar cada una; toma el cerrojo una sola vez, por lo que procesar no debe usar
+    // esta cola. No muestra mensajes si la cola esta vacia. Devuelve las extraidas
+    template <typename Procesar>
+    size_t drenar(size_t maximo, Procesar procesar) {
+        size_t extraidas = 0;
+        uint64_t lsn;
+        {
+            lock_guard bloqueo(cerrojo);
+            time_t ahora = time(0);
+            while (extraidas < maximo && cantidad) {
+                procesar(static_cast<const RegistroActividad&>(buffer[inicio]));
+                metricas.registrarPermanencia(ahora - buffer[inicio].hora);
+                desencolar();
+                ++extraidas;
+            }
+            lsn = anotarDesencolado(extraidas); // un solo registro para todo el lote
+        }
+        if (extraidas) espacioLibre.notify_all();
+        confirmar(lsn);
+        return extraidas;
+    }
+
+    // muestra las actividades asignadas a un usuario recorriendo solo su cadena
+    void mostrar(const string& usuario) const {
+        uint32_t idUsuario = tablaUsuarios.buscar(toLowerCase(usuario));
+        lock_guard bloqueo(cerrojo);
+        if (!cantidad) {
+            cout << "No hay actividades en la cola general." << endl;
+            return;
+        }
+
+        if (idUsuario >= cadenas.size() || !cadenas[idUsuario].pendientes) {
+            cout << "No hay actividades asignadas para " << usuario << "." << endl;
+            return;
+        }
+
+        for (uint64_t s = cadenas[idUsuario].primero; s != RegistroActividad::sinSiguiente;) {
+            const RegistroActividad& actual = buffer[posicion(s)];
+            cout << "- Actividad: " << actual.getActividad() << (actual.vencida ? " [VENCIDA]" : "")
+                 << ", Hora: " << ctime(&(actual.hora));
+            time_t vence = actual.temporizador != RuedaTemporizadores::sinTemporizador ? plazos.vencimiento(actual.temporizador) : 0;
+            if (vence) cout << "  Vence: " << ctime(&vence); // muestra el plazo si lo tiene
+            cout << endl;
+            s = actual.siguienteUsuario;
+        }
+    }
+
+    // devuelve el proximo vencimiento programado de una actividad, o 0 si no tiene
+    time_t getVencimiento(const RegistroActividad& registro) const {
+        lock_guard bloqueo(cerrojo);
+        return registro.temporizador != RuedaTemporizadores::sinTemporizador ? plazos.vencimiento(registro.temporizador) : 0;
+    }
+
+    // procesa los plazos vencidos hasta ahora llamando a alVencer(registro) por cada uno;
+    // registro.vencida indica si ya habia vencido antes. alVencer devuelve el momento del
+    // siguiente aviso, o 0 para no volver a avisar. Devuelve los vencimientos procesados
+    template <typename AlVencer>
+    size_t procesarVencimientos(time_t ahora, AlVencer alVencer) {
+        lock_guard bloqueo(cerrojo);
+        return plazos.avanzar(ahora, [&](uint32_t, uint64_t secuencia) {
+            RegistroActividad& registro = buffer[posicion(secuencia)];
+            time_t siguienteAviso = alVencer(static_cast<const RegistroActividad&>(registro));
+            registro.vencida = true;
+            if (!siguienteAviso) registro.temporizador = RuedaTemporizadores::sinTemporizador;
+            return siguienteAviso;
+        });
+    }
+
+    // devuelve cuantas actividades pendientes tiene un usuario, en O(1)
+    int pendientes(const string& usuario) const {
+        uint32_t idUsuario = tablaUsuarios.buscar(toLowerCase(usuario));
+        lock_guard bloqueo(cerrojo);
+        return idUsuario < cadenas.size() ? cadenas[idUsuario].pendientes : 0;
+    }
+
+    // verifica si un usuario tiene actividades asignadas, en O(1)
+    bool tieneActividades(const string& usuario) const {
+        return pendientes(usuario) > 0;
+    }
+};
+
+#endif //ACTIVIDADES_H
@@ -0,0 +1,137 @@
+#ifndef ACUMULADOS_H
+#define ACUMULADOS_H
+
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <utility>
+#include <vector>
+#include "perfiles.h"
+using namespace std;
+
+// -----ACUMULADOS POR PERIODO-----
+// resolucion de una serie de accesos
+enum class Resolucion : unsigned char { Minuto, Hora, Dia };
+
+// accesos por perfil agregados por minuto, hora y dia (UTC). Cada insercion suma en los tres
+// niveles; con la edad se eliminan los minutos y despues las horas, de modo que solo los
+// dias se guardan siempre. Una consulta sobre meses usa unos cientos de celdas
+class AcumuladosAccesos {
+public:
+    static constexpr size_t numPerfiles = tablaPerfiles.size(); // posicion 0: perfiles no registrados
+    using Celda = array<uint64_t, numPerfiles>; // accesos de cada perfil en un periodo
+
+    static constexpr time_t duraciones[] = {60, 3600, 86400}; // segundos por periodo, indexado por Resolucion
+    static constexpr int64_t minutosRetenidos = 48 * 60; // dos dias
+    static constexpr int64_t horasRetenidas = 90 * 24; // noventa dias
+
+private:
+    array<map<int64_t, Celda>, 3> niveles; // celdas de cada resolucion por numero de periodo
+    int64_t minutoMasReciente = INT64_MIN; // minuto mas reciente registrado
+
+    static int64_t periodo(time_t hora, Resolucion resolucion) {
+        time_t duracion = duraciones[static_cast<int>(resolucion)];
+        return hora >= 0 ? hora / duracion : -((-hora + duracion - 1) / duracion);
+    }
+
+    static size_t indicePerfil(int perfil) {
+        return buscarPerfil(perfil) ? static_cast<size_t>(perfil) : 0;
+    }
+
+    // primer periodo de la resolucion que sigue retenido
+    int64_t primeroRetenido(Resolucion resolucion) const {
+        if (minutoMasReciente == INT64_MIN) return INT64_MIN;
+        if (resolucion == Resolucion::Minuto) return minutoMasReciente - minutosRetenidos + 1;
+        if (resolucion == Resolucion::Hora) return minutoMasReciente / 60 - horasRetenidas + 1;
+        return INT64_MIN;
+    }
+
+    // elimina las celdas de minutos y horas que ya no se retienen
+    void compactar() {
+        for (Resolucion r : {Resolucion::Minuto, Resolucion::Hora}) {
+            auto& nivel = niveles[static_cast<int>(r)];
+            nivel.erase(nivel.begin(), nivel.lower_bound(primeroRetenido(r)));
+        }
+    }
+
+    // suma las celdas de un nivel en [desde, hasta) periodos
+    uint64_t sumar(Resolucion resolucion, int64_t desde, int64_t hasta, int perfil) const {
+        const auto& nivel = niveles[static_cast<int>(resolucion)];
+        uint64_t total = 0;
+        for (auto it = nivel.lower_bound(desde); it != nivel.end() && it->first < hasta; ++it) {
+            total += sumaCelda(it->second, perfil);
+        }
+        return total;
+    }
+
+public:
+    // suma de una celda para un perfil, o de todos con perfil 0
+    static uint64_t sumaCelda(const Celda& celda, int perfil) {
+        if (perfil) return celda[indicePerfil(perfil)];
+        uint64_t total = 0;
+        for (uint64_t c : celda) total += c;
+        return total;
+    }
+
+    void registrar(int perfil, time_t hora) {
+        size_t indice = indicePerfil(perfil);
+        int64_t minuto = periodo(hora, Resolucion::Minuto);
+        niveles[static_cast<int>(Resolucion::Dia)][periodo(hora, Resolucion::Dia)][indice]++;
+        if (minuto / 60 >= primeroRetenido(Resolucion::Hora)) niveles[static_cast<int>(Resolucion::Hora)][minuto / 60][indice]++;
+        if (minuto >= primeroRetenido(Resolucion::Minuto)) niveles[static_cast<int>(Resolucion::Minuto)][minuto][indice]++;
+        if (minuto > minutoMasReciente) {
+            bool cambiaHora = minutoMasReciente == INT64_MIN || minuto / 60 != minutoMasReciente / 60;
+            minutoMasReciente = minuto;
+            if (cambiaHora) compactar(); // basta con compactar una vez por hora
+        }
+    }
+
+    // accesos en [desde, hasta) de un perfil (0 para todos), con los extremos ajustados al
+    // minuto. Usa dias completos, despues horas y minutos en los extremos; si un extremo ya
+    // no tiene la resolucion necesaria se amplia al periodo retenido que lo contiene
+    uint64_t contar(time_t desde, time_t hasta, int perfil = 0) const {
+        int64_t m = periodo(desde, Resolucion::Minuto), mFin = periodo(hasta - 1, Resolucion::Minuto) + 1;
+        uint64_t total = 0;
+        while (m < mFin) {
+            if (m % 1440 == 0 && m + 1440 <= mFin) { // dia completo
+                total += sumar(Resolucion::Dia, m / 1440, m / 1440 + 1, perfil);
+                m += 1440;
+            } else if (m % 60 == 0 && m + 60 <= mFin && m / 60 >= primeroRetenido(Resolucion::Hora)) { // hora completa
+                total += sumar(Resolucion::Hora, m / 60, m / 60 + 1, perfil);
+                m += 60;
+            } else if (m >= primeroRetenido(Resolucion::Minuto)) {
+                int64_t fin = min(mFin, (m / 60 + 1) * 60); // minutos sueltos hasta la siguiente hora
+                total += sumar(Resolucion::Minuto, m, fin, perfil);
+                m = fin;
+            } else if (m / 60 >= primeroRetenido(Resolucion::Hora)) { // minuto ya compactado: su hora
+                total += sumar(Resolucion::Hora, m / 60, m / 60 + 1, perfil);
+                m = (m / 60 + 1) * 60;
+            } else { // hora ya compactada: su dia
+                total += sumar(Resolucion::Dia, m / 1440, m / 1440 + 1, perfil);
+                m = (m / 1440 + 1) * 1440;
+            }
+        }
+        return total;
+    }
+
+    // celdas de una resolucion con accesos en [desde, hasta), como (inicio del periodo, celda).
+    // Vacia si la resolucion ya no se retiene para ese rango
+    vector<pair<time_t, Celda>> serie(time_t desde, time_t hasta, Resolucion resolucion) const {
+        vector<pair<time_t, Celda>> resultado;
+        const auto& nivel = niveles[static_cast<int>(resolucion)];
+        time_t duracion = duraciones[static_cast<int>(resolucion)];
+        int64_t fin = periodo(hasta - 1, resolucion) + 1;
+        for (auto it = nivel.lower_bound(periodo(desde, resolucion)); it != nivel.end() && it->first < fin; ++it) {
+            resultado.emplace_back(static_cast<time_t>(it->first * duracion), it->second);
+        }
+        return resultado;
+    }
+
+    // celdas guardadas en cada nivel
+    size_t celdas(Resolucion resolucion) const {
+        return niveles[static_cast<int>(resolucion)].size();
+    }
+};
+
+#endif // ACUMULADOS_H
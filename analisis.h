@@ -0,0 +1,246 @@
+#ifndef ANALISIS_H
+#define ANALISIS_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include "accesos.h"
+#include "actividades.h"
+#include "metricas.h"
+using namespace std;
+
+// -----ANALISTA-----
+// escribe los usuarios distintos estimados en las ultimas 24 horas y en la ultima hora
+inline void escribirDistintosRecientes(ostream& salida, const DistintosPorPeriodo& distintos, time_t ahora) {
+    salida << "Usuarios distintos en las ultimas 24 h: ~" << llround(distintos.estimar(ahora - DistintosPorPeriodo::segundosDia, ahora + 1))
+           << ", en la ultima hora: ~" << llround(distintos.estimar(ahora - DistintosPorPeriodo::segundosHora, ahora + 1))
+           << " (error tipico " << 100 * HyperLogLog::errorRelativo() << "%)\n";
+}
+
+// muestra los usuarios mas activos segun los bocetos, con la cota de error de cada cifra
+inline void generarEstadisticasAproximadas(const EstadisticasAproximadas& aproximadas, const DistintosPorPeriodo& distintos, size_t k = 10) {
+    const EspacioAhorro& principales = aproximadas.principales;
+    const BocetoCountMin& frecuencias = aproximadas.frecuencias;
+    // la cuenta real esta entre cuenta - error y cuenta, y Count-Min da otra cota superior;
+    // se ordena por la menor de las dos cotas, que descarta a los recien llegados con error alto
+    vector<pair<uint64_t, EspacioAhorro::Contador>> top;
+    for (auto& contador : principales.principales(principales.getCapacidad())) {
+        uint64_t cota = min(contador.cuenta, frecuencias.estimar(contador.clave));
+        top.emplace_back(cota, std::move(contador));
+    }
+    k = min(k, top.size());
+    partial_sort(top.begin(), top.begin() + k, top.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    top.resize(k);
+
+    cout << "Estadisticas aproximadas de accesos (" << principales.getTotal() << " accesos):\n"; // encabezado
+    ofstream archivo("informe_accesos.txt");
+    archivo << "Informe de Accesos (aproximado):\n";
+    archivo << "Total de accesos: " << principales.getTotal() << "\n";
+    archivo << "Usuarios distintos: ~" << llround(distintos.estimarTotal()) << "\n";
+    escribirDistintosRecientes(archivo, distintos, time(0));
+    for (const auto& [cota, contador] : top) {
+        cout << contador.clave << ": <= " << cota << " accesos (al menos " << contador.cuenta - contador.error << ")\n";
+        archivo << contador.clave << ": <= " << cota << " accesos (al menos " << contador.cuenta - contador.error << ")\n";
+    }
+    cout << "Usuarios distintos: ~" << llround(distintos.estimarTotal()) << "\n";
+    escribirDistintosRecientes(cout, distintos, time(0));
+    cout << "Cota de error: cada cuenta del top-" << principales.getCapacidad() << " excede la real en <= "
+         << principales.errorMaximo() << "; las estimaciones Count-Min exceden en <= " << frecuencias.errorMaximo()
+         << " con probabilidad " << frecuencias.getConfianza() << "\n";
+    archivo << "Error top-" << principales.getCapacidad() << ": <= " << principales.errorMaximo()
+            << "; error Count-Min: <= " << frecuencias.errorMaximo() << " (confianza " << frecuencias.getConfianza() << ")\n";
+    archivo.close(); // cierra el archivo
+}
+
+// genera estadisticas de accesos a partir de los conteos que la lista mantiene al
+// insertar, por lo que su coste depende del numero de usuarios y no del de accesos
+inline void generarEstadisticasAccesos(ListaEnlazadaAccesos& accesos) {
+    if (const EstadisticasAproximadas* aproximadas = accesos.getAproximadas()) {
+        generarEstadisticasAproximadas(*aproximadas, accesos.getDistintos()); // la lista no guarda conteos exactos
+        return;
+    }
+    // la tabla no tiene orden: se copia y se ordena por nombre solo al generar el informe;
+    // ordenar copias evita saltar a la tabla en cada comparacion
+    vector<pair<string, int>> conteos; // accesos por usuario
+    conteos.reserve(accesos.getConteos().size());
+    accesos.getConteos().recorrer([&](const string& usuario, int n) { conteos.emplace_back(usuario, n); });
+    sort(conteos.begin(), conteos.end());
+
+    time_t ahora = time(0);
+
+    cout << "Estadisticas de accesos:\n"; // encabezado
+    for (const auto& par : conteos) { // recorre los conteos
+        cout << par.first << ": " << par.second << " accesos\n"; // muestra el conteo para cada usuario
+    }
+    cout << "Total de accesos: " << accesos.getTotalAccesos() << ", usuarios distintos: " << conteos.size() << "\n";
+    escribirDistintosRecientes(cout, accesos.getDistintos(), ahora);
+
+    // guarda el informe en un archivo
+    ofstream archivo("informe_accesos.txt");
+    archivo << "Informe de Accesos:\n";
+    archivo << "Total de accesos: " << accesos.getTotalAccesos() << "\n";
+    archivo << "Usuarios distintos: " << conteos.size() << "\n";
+    escribirDistintosRecientes(archivo, accesos.getDistintos(), ahora);
+    for (const auto& par : conteos) {
+        archivo << par.first << ": " << par.second << " accesos\n";
+    }
+    archivo.close(); // cierra el archivo
+}
+
+// -----PANEL DE ACCESOS-----
+// escribe una fila del panel: inicio del periodo y accesos de cada perfil registrado
+inline void escribirFilaPanel(ostream& salida, time_t inicio, const AcumuladosAccesos::Celda& celda, const char* formato) {
+    char fecha[32];
+    strftime(fecha, sizeof(fecha), formato, localtime(&inicio));
+    salida << fecha;
+    for (size_t perfil = 1; perfil < AcumuladosAccesos::numPerfiles; ++perfil) salida << "  " << celda[perfil];
+    salida << "  " << AcumuladosAccesos::sumaCelda(celda, 0) << "\n";
+}
+
+// muestra los accesos por perfil de las ultimas 24 horas, hora a hora, y de los ultimos
+// 30 dias, dia a dia, leyendo solo las celdas acumuladas
+inline void generarPanelAccesos(const ListaEnlazadaAccesos& accesos, time_t ahora = time(0)) {
+    const AcumuladosAccesos& acumulados = accesos.getAcumulados();
+
+    cout << "Periodo";
+    for (size_t perfil = 1; perfil < AcumuladosAccesos::numPerfiles; ++perfil) cout << "  " << tablaPerfiles[perfil].nombre;
+    cout << "  total\n";
+
+    cout << "Ultimas 24 horas:\n";
+    for (const auto& [inicio, celda] : acumulados.serie(ahora - 23 * 3600, ahora + 1, Resolucion::Hora)) {
+        escribirFilaPanel(cout, inicio, celda, "%d/%m %H:00");
+    }
+    cout << "Ultimos 30 dias:\n";
+    for (const auto& [inicio, celda] : acumulados.serie(ahora - 29 * 86400, ahora + 1, Resolucion::Dia)) {
+        escribirFilaPanel(cout, inicio, celda, "%d/%m/%Y");
+    }
+    cout << "Accesos en la ultima hora: " << acumulados.contar(ahora - 3599, ahora + 1)
+         << ", en los ultimos 30 dias: " << acumulados.contar(ahora - 30 * 86400 + 1, ahora + 1) << "\n";
+}
+
+// -----ACTIVIDADES SOSPECHOSAS-----
+// genera un informe de los pares (usuario, actividad) que superan el umbral dentro de la
+// ventana actual del detector; su coste depende de los pares en la ventana, no de la cola
+inline void generarInformeSospechosas(DetectorSospechosas& detector, time_t ahora = time(0)) {
+    detector.actualizar(ahora); // descarta lo que ya salio de la ventana
+
+    vector<tuple<const string*, const string*, int>> sospechosas; // usuario, actividad y repeticiones
+    detector.recorrerSospechosas([&](uint32_t usuario, uint32_t actividad, int repeticiones) {
+        sospechosas.emplace_back(&tablaUsuarios.valor(usuario), &catalogoActividades.descripcion(actividad), repeticiones);
+    });
+    // ordena por usuario y actividad solo las sospechosas, al mostrarlas
+    sort(sospechosas.begin(), sospechosas.end(), [](const auto& a, const auto& b) {
+        return tie(*get<0>(a), *get<1>(a)) < tie(*get<0>(b), *get<1>(b));
+    });
+
+    cout << "Informe de actividades sospechosas (mas de " << detector.getUmbral() << " repeticiones en "
+         << detector.getIntervalo() / 60 << " minutos):\n"; // mensaje inicial en consola
+    ofstream archivo("informe_sospechosas.txt"); // abre un archivo para guardar el informe
+    archivo << "Informe de Actividades Sospechosas:\n"; // escribe el encabezado en el archivo
+    for (const auto& [usuario, actividad, repeticiones] : sospechosas) {
+        cout << "Usuario: " << *usuario << ", Actividad: " << *actividad
+             << ", Repeticiones: " << repeticiones << "\n"; // imprime los detalles en consola
+        archivo << "Usuario: " << *usuario << ", Actividad: " << *actividad
+                << ", Repeticiones: " << repeticiones << "\n"; // guarda los detalles en el archivo
+    }
+    archivo.close(); // cierra el archivo después de guardar los datos
+}
+
+// -----LATENCIAS DE LOGIN-----
+// objetivo de coste de la instrumentacion, en porcentaje del tiempo de las fases medidas
+constexpr double objetivoSobrecargaLogin = 2.0;
+
+// mide en nanosegundos el coste medio que la instrumentacion añade a una fase, con el mismo
+// muestreo que las metricas reales: ejecuta fases vacias sobre unas metricas auxiliares
+inline double medirSobrecargaInstrumentacion() {
+    constexpr int iteraciones = 1 << 20;
+    auto auxiliares = make_unique<MetricasLogin>(); // no contamina las metricas reales
+    uint64_t suma = 0;
+    auto inicio = chrono::steady_clock::now();
+    for (int i = 0; i < iteraciones; ++i) {
+        suma += auxiliares->medir(FaseLogin::Busqueda, [i] { return i; });
+    }
+    auto total = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count();
+    volatile uint64_t sumidero = suma; // evita que se elimine el bucle
+    (void)sumidero;
+    return static_cast<double>(total) / iteraciones;
+}
+
+// muestra los percentiles de latencia por fase y los guarda en formato JSON, junto con el
+// coste de la instrumentacion respecto al tiempo total de las fases medidas
+inline void generarInformeLatencias() {
+    double sobrecarga = medirSobrecargaInstrumentacion();
+    double trabajo = 0.0; // ns estimados de todas las ejecuciones de las fases
+    double sobrecargaTotal = 0.0; // ns añadidos por la instrumentacion a esas ejecuciones
+    for (size_t i = 0; i < nombresFaseLogin.size(); ++i) {
+        FaseLogin fase = static_cast<FaseLogin>(i);
+        const HistogramaLatencia& h = metricasLogin.getFase(fase);
+        if (h.getMuestras() == 0) continue;
+        uint64_t ejecuciones = metricasLogin.getEjecuciones(fase);
+        trabajo += ejecuciones * h.media() * RelojMetricas::nsPorTick();
+        sobrecargaTotal += ejecuciones * sobrecarga;
+    }
+    double porcentaje = trabajo > 0 ? 100.0 * sobrecargaTotal / trabajo : 0.0;
+
+    cout << "Latencias de inicio de sesion (ns, una de cada " << MetricasLogin::intervaloMuestreo << " ejecuciones):\n"; // encabezado
+    ofstream archivo("latencias_login.json"); // volcado legible por maquina
+    archivo << "{\"unidad\":\"ns\",\"intervalo_muestreo\":" << MetricasLogin::intervaloMuestreo
+            << ",\"sobrecarga_por_fase\":" << sobrecarga << ",\"sobrecarga_porcentaje\":" << porcentaje
+            << ",\"objetivo_porcentaje\":" << objetivoSobrecargaLogin << ",\"fases\":{";
+    for (size_t i = 0; i < nombresFaseLogin.size(); ++i) {
+        FaseLogin fase = static_cast<FaseLogin>(i);
+        const HistogramaLatencia& h = metricasLogin.getFase(fase);
+        auto ns = [](uint64_t ticks) { return MetricasLogin::nanosegundos(ticks); };
+        cout << nombresFaseLogin[i] << ": ejecuciones " << metricasLogin.getEjecuciones(fase) << ", muestras " << h.getMuestras()
+             << ", p50 " << ns(h.percentil(50)) << ", p99 " << ns(h.percentil(99))
+             << ", p999 " << ns(h.percentil(99.9)) << ", max " << ns(h.getMaximo()) << "\n";
+        archivo << (i ? "," : "") << "\"" << nombresFaseLogin[i] << "\":{\"ejecuciones\":" << metricasLogin.getEjecuciones(fase)
+                << ",\"muestras\":" << h.getMuestras() << ",\"p50\":" << ns(h.percentil(50)) << ",\"p99\":" << ns(h.percentil(99))
+                << ",\"p999\":" << ns(h.percentil(99.9)) << ",\"max\":" << ns(h.getMaximo()) << "}";
+    }
+    archivo << "}}\n";
+    archivo.close(); // cierra el archivo
+
+    cout << "Sobrecarga de instrumentacion: " << sobrecarga << " ns por fase (" << porcentaje
+         << "% del tiempo de las fases; objetivo < " << objetivoSobrecargaLogin << "%)\n";
+}
+
+// muestra y vuelca a metricas_cola.json la profundidad, el ritmo y las esperas de una cola
+inline void generarInformeCola(const ColaActividades& cola) {
+    const MetricasCola& m = cola.getMetricas();
+    LimiteCola limite = cola.getLimite();
+    const HistogramaLatencia& bloqueos = m.getBloqueos();
+    const HistogramaLatencia& permanencia = m.getPermanencia();
+
+    cout << "Metricas de la cola general:\n"; // encabezado
+    cout << "Profundidad: " << cola.tamano() << " (maxima " << m.getProfundidadMaxima() << ", capacidad ";
+    if (limite.capacidad) cout << limite.capacidad << ", politica " << nombresPoliticaDesborde[static_cast<int>(limite.politica)];
+    else cout << "sin limite";
+    cout << ")\n";
+    cout << "Encoladas: " << m.getEncoladas() << " (" << m.tasaEncolado() << " por segundo), rechazadas: "
+         << m.getRechazadas() << ", descartadas: " << m.getDescartadas() << "\n";
+    cout << "Espera de productores (ns): muestras " << bloqueos.getMuestras() << ", p50 " << bloqueos.percentil(50)
+         << ", p99 " << bloqueos.percentil(99) << ", max " << bloqueos.getMaximo() << "\n";
+    cout << "Permanencia en cola (s): muestras " << permanencia.getMuestras() << ", p50 " << permanencia.percentil(50)
+         << ", p99 " << permanencia.percentil(99) << ", max " << permanencia.getMaximo() << "\n";
+
+    ofstream archivo("metricas_cola.json"); // volcado legible por maquina
+    archivo << "{\"profundidad\":" << cola.tamano() << ",\"profundidad_maxima\":" << m.getProfundidadMaxima()
+            << ",\"capacidad\":" << limite.capacidad
+            << ",\"politica\":\"" << nombresPoliticaDesborde[static_cast<int>(limite.politica)] << "\""
+            << ",\"encoladas\":" << m.getEncoladas() << ",\"encoladas_por_segundo\":" << m.tasaEncolado()
+            << ",\"rechazadas\":" << m.getRechazadas() << ",\"descartadas\":" << m.getDescartadas()
+            << ",\"espera_productores_ns\":{\"muestras\":" << bloqueos.getMuestras() << ",\"p50\":" << bloqueos.percentil(50)
+            << ",\"p99\":" << bloqueos.percentil(99) << ",\"max\":" << bloqueos.getMaximo() << "}"
+            << ",\"permanencia_s\":{\"muestras\":" << permanencia.getMuestras() << ",\"p50\":" << permanencia.percentil(50)
+            << ",\"p99\":" << permanencia.percentil(99) << ",\"max\":" << permanencia.getMaximo() << "}}\n";
+    archivo.close(); // cierra el archivo
+}
+
+#endif //ANALISIS_H
@@ -0,0 +1,110 @@
+#ifndef ARNES_H
+#define ARNES_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+using namespace std;
+
+// resultado de una medicion para un tamaño concreto
+struct ResultadoBenchmark {
+    string nombre; // nombre de la operacion medida
+    size_t elementos; // tamaño de la estructura
+    size_t operaciones; // operaciones realizadas durante la medicion
+    double segundos; // tiempo total medido
+    bool omitido; // true si se salto por exceder el presupuesto de tiempo
+    uint64_t reservas = 0; // reservas de memoria hechas durante la medicion
+};
+
+// reservas de memoria del proceso; las cuenta el operator new que define benchmarks.cpp
+inline atomic<uint64_t> reservasMemoria{0};
+
+// buffer que descarta todo lo que recibe, para silenciar cout durante las mediciones
+class BufferNulo : public streambuf {
+protected:
+    int overflow(int c) override {
+        return c;
+    }
+    streamsize xsputn(const char*, streamsize n) override {
+        return n;
+    }
+};
+
+// evita que el compilador elimine llamadas cuyo resultado no se usa
+template <typename T>
+void noOptimizar(const T& valor) {
+    asm volatile("" : : "r,m"(valor) : "memory");
+}
+
+// arnes de benchmarks: mide cada operacion en tamaños 10^3, 10^4, ... hasta maxElementos
+class ArnesBenchmarks {
+private:
+    vector<ResultadoBenchmark> resultados; // resultados acumulados
+    size_t maxElementos; // mayor tamaño a medir
+    double presupuesto; // segundos maximos estimados por medicion
+    BufferNulo nulo; // destino de la salida silenciada
+
+public:
+    ArnesBenchmarks(size_t maxElementos, double presupuesto) : maxElementos(maxElementos), presupuesto(presupuesto) {}
+
+    // prepara(n) construye el estado fuera de la medicion; medir(estado, n) devuelve las
+    // operaciones realizadas. El tiempo del siguiente tamaño se estima con el crecimiento
+    // observado (al menos lineal) y, si supera el presupuesto, se omiten los restantes
+    template <typename Preparar, typename Medir>
+    void ejecutar(const string& nombre, Preparar preparar, Medir medir) {
+        streambuf* original = cout.rdbuf(&nulo); // silencia los mensajes de las estructuras
+        {
+            auto calentamiento = preparar(1000); // ejecucion previa sin medir
+            medir(calentamiento, 1000);
+        }
+        cout.rdbuf(original);
+
+        bool omitir = false;
+        double anterior = 0.0; // segundos del tamaño anterior
+        for (size_t n = 1000; n <= maxElementos; n *= 10) {
+            if (omitir) {
+                resultados.push_back({nombre, n, 0, 0.0, true});
+                cerr << nombre << " n=" << n << ": omitido" << endl;
+                continue;
+            }
+            auto estado = preparar(n);
+            original = cout.rdbuf(&nulo);
+            uint64_t reservasPrevias = reservasMemoria.load(memory_order_relaxed);
+            auto inicio = chrono::steady_clock::now();
+            size_t operaciones = medir(estado, n);
+            double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+            uint64_t reservas = reservasMemoria.load(memory_order_relaxed) - reservasPrevias;
+            cout.rdbuf(original);
+            resultados.push_back({nombre, n, operaciones, segundos, false, reservas});
+            cerr << nombre << " n=" << n << ": " << segundos * 1e9 / operaciones << " ns/op, " << reservas << " reservas" << endl;
+            double crecimiento = anterior > 0.0 ? max(10.0, segundos / anterior) : 10.0;
+            omitir = segundos * crecimiento > presupuesto;
+            anterior = segundos;
+        }
+    }
+
+    // escribe los resultados en formato JSON
+    void escribirJson(ostream& salida) const {
+        salida << "{\"fecha\":" << time(nullptr) << ",\"benchmarks\":[";
+        for (size_t i = 0; i < resultados.size(); ++i) {
+            const ResultadoBenchmark& r = resultados[i];
+            salida << (i ? ",\n" : "\n") << "{\"nombre\":\"" << r.nombre << "\",\"elementos\":" << r.elementos;
+            if (r.omitido) {
+                salida << ",\"omitido\":true}";
+                continue;
+            }
+            salida << ",\"operaciones\":" << r.operaciones << ",\"segundos\":" << r.segundos
+                   << ",\"ns_por_operacion\":" << r.segundos * 1e9 / r.operaciones << ",\"reservas\":" << r.reservas << "}";
+        }
+        salida << "\n]}\n";
+    }
+};
+
+#endif //ARNES_H
@@ -0,0 +1,477 @@
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "arnes.h"
+#include "accesos.h"
+#include "actividades.h"
+#include "analisis.h"
+#include "exportador.h"
+#include "tabla_hash.h"
+using namespace std;
+
+// -----CONTEO DE RESERVAS-----
+// reemplaza todas las formas globales de operator new y delete (simples, de arreglo,
+// alineadas y sin excepciones) para que el arnes anote las reservas de cada medicion.
+// Reservar y liberar quedan fuera de linea: si se expandieran en quien llama, el
+// compilador veria un free sobre memoria de operator new y avisaria de un desajuste
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCHMARKS_FUERA_DE_LINEA __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define BENCHMARKS_FUERA_DE_LINEA __declspec(noinline)
+#else
+#define BENCHMARKS_FUERA_DE_LINEA
+#endif
+
+// reserva bytes con el alineamiento pedido (0 para el de malloc); nullptr si no hay memoria
+BENCHMARKS_FUERA_DE_LINEA static void* reservarContando(size_t bytes, size_t alineamiento = 0) noexcept {
+    reservasMemoria.fetch_add(1, memory_order_relaxed);
+    if (!bytes) bytes = 1;
+    if (alineamiento <= alignof(max_align_t)) return malloc(bytes);
+#ifdef _MSC_VER
+    return _aligned_malloc(bytes, alineamiento);
+#else
+    return aligned_alloc(alineamiento, (bytes + alineamiento - 1) / alineamiento * alineamiento); // multiplo del alineamiento
+#endif
+}
+
+BENCHMARKS_FUERA_DE_LINEA static void liberarContando(void* memoria, size_t alineamiento = 0) noexcept {
+#ifdef _MSC_VER
+    if (alineamiento > alignof(max_align_t)) return _aligned_free(memoria);
+#endif
+    (void)alineamiento;
+    free(memoria);
+}
+
+static void* reservarOLanzar(size_t bytes, size_t alineamiento = 0) {
+    if (void* memoria = reservarContando(bytes, alineamiento)) return memoria;
+    throw bad_alloc();
+}
+
+void* operator new(size_t bytes) { return reservarOLanzar(bytes); }
+void* operator new[](size_t bytes) { return reservarOLanzar(bytes); }
+void* operator new(size_t bytes, align_val_t alineamiento) { return reservarOLanzar(bytes, static_cast<size_t>(alineamiento)); }
+void* operator new[](size_t bytes, align_val_t alineamiento) { return reservarOLanzar(bytes, static_cast<size_t>(alineamiento)); }
+void* operator new(size_t bytes, const nothrow_t&) noexcept { return reservarContando(bytes); }
+void* operator new[](size_t bytes, const nothrow_t&) noexcept { return reservarContando(bytes); }
+void* operator new(size_t bytes, align_val_t alineamiento, const nothrow_t&) noexcept { return reservarContando(bytes, static_cast<size_t>(alineamiento)); }
+void* operator new[](size_t bytes, align_val_t alineamiento, const nothrow_t&) noexcept { return reservarContando(bytes, static_cast<size_t>(alineamiento)); }
+
+void operator delete(void* memoria) noexcept { liberarContando(memoria); }
+void operator delete[](void* memoria) noexcept { liberarContando(memoria); }
+void operator delete(void* memoria, size_t) noexcept { liberarContando(memoria); }
+void operator delete[](void* memoria, size_t) noexcept { liberarContando(memoria); }
+void operator delete(void* memoria, align_val_t alineamiento) noexcept { liberarContando(memoria, static_cast<size_t>(alineamiento)); }
+void operator delete[](void* memoria, align_val_t alineamiento) noexcept { liberarContando(memoria, static_cast<size_t>(alineamiento)); }
+void operator delete(void* memoria, size_t, align_val_t alineamiento) noexcept { liberarContando(memoria, static_cast<size_t>(alineamiento)); }
+void operator delete[](void* memoria, size_t, align_val_t alineamiento) noexcept { liberarContando(memoria, static_cast<size_t>(alineamiento)); }
+void operator delete(void* memoria, const nothrow_t&) noexcept { liberarContando(memoria); }
+void operator delete[](void* memoria, const nothrow_t&) noexcept { liberarContando(memoria); }
+void operator delete(void* memoria, align_val_t alineamiento, const nothrow_t&) noexcept { liberarContando(memoria, static_cast<size_t>(alineamiento)); }
+void operator delete[](void* memoria, align_val_t alineamiento, const nothrow_t&) noexcept { liberarContando(memoria, static_cast<size_t>(alineamiento)); }
+
+// -----DATOS DE PRUEBA-----
+const string actividadesPrueba[] = {
+    "Actualizar datos personales.",
+    "Configurar autenticacion en dos pasos.",
+    "Revisar historial de accesos.",
+    "Aceptar terminos y condiciones."
+};
+
+const time_t horaBase = 1700000000; // hora fija para que los resultados sean reproducibles
+
+// nombre del usuario i
+string nombreUsuario(size_t i) {
+    return "usuario" + to_string(i);
+}
+
+// crea una lista con n accesos repartidos entre el numero de usuarios indicado; inserta
+// del mas reciente al mas antiguo para que cada insercion sea en la cabeza
+unique_ptr<ListaEnlazadaAccesos> crearLista(size_t n, size_t usuarios, ModoEstadisticas modo = ModoEstadisticas::Exacto) {
+    auto lista = make_unique<ListaEnlazadaAccesos>(modo);
+    for (size_t i = n; i-- > 0;) {
+        lista->insertar(nombreUsuario(i % usuarios), horaBase + static_cast<time_t>(i), 1);
+    }
+    return lista;
+}
+
+// crea una cola con n actividades repartidas entre el numero de usuarios indicado
+unique_ptr<ColaActividades> crearCola(size_t n, size_t usuarios) {
+    auto cola = make_unique<ColaActividades>();
+    for (size_t i = 0; i < n; ++i) {
+        cola->enqueue(nombreUsuario(i % usuarios), actividadesPrueba[i % 4]);
+    }
+    return cola;
+}
+
+// crea un detector con n asignaciones repartidas entre 1000 usuarios dentro de su ventana
+unique_ptr<DetectorSospechosas> crearDetector(size_t n) {
+    auto detector = make_unique<DetectorSospechosas>();
+    for (size_t i = 0; i < n; ++i) {
+        detector->registrar(tablaUsuarios.internar(nombreUsuario(i % 1000)),
+                            catalogoActividades.internar(actividadesPrueba[i % 4]), horaBase);
+    }
+    return detector;
+}
+
+// columna de n horas consecutivas en orden inverso, como la que deja crearLista
+unique_ptr<vector<time_t>> crearColumnaHoras(size_t n) {
+    auto horas = make_unique<vector<time_t>>(n);
+    for (size_t i = 0; i < n; ++i) (*horas)[i] = horaBase + static_cast<time_t>(n - 1 - i);
+    return horas;
+}
+
+// nombres de n usuarios distintos
+unique_ptr<vector<string>> crearNombres(size_t n) {
+    auto nombres = make_unique<vector<string>>(n);
+    for (size_t i = 0; i < n; ++i) (*nombres)[i] = nombreUsuario(i);
+    return nombres;
+}
+
+// cuenta dos veces cada nombre en una tabla nueva del tipo indicado
+template <typename Tabla>
+size_t contarNombres(const vector<string>& nombres) {
+    Tabla conteos;
+    for (int vuelta = 0; vuelta < 2; ++vuelta) {
+        for (const string& nombre : nombres) conteos[nombre]++;
+    }
+    noOptimizar(conteos.size());
+    return 2 * nombres.size();
+}
+
+// cuenta dos veces cada par (usuario i / 4, actividad i % 4), con clave compuesta de ids
+template <typename Tabla>
+size_t contarPares(size_t n) {
+    Tabla conteos;
+    for (int vuelta = 0; vuelta < 2; ++vuelta) {
+        for (size_t i = 0; i < n; ++i) conteos[(static_cast<uint64_t>(i / 4) << 32) | (i % 4)]++;
+    }
+    noOptimizar(conteos.size());
+    return 2 * n;
+}
+
+// -----BENCHMARKS-----
+void benchmarksAccesos(ArnesBenchmarks& arnes) {
+    // insercion en orden cronologico: cada acceso nuevo es el mas reciente
+    arnes.ejecutar("ListaEnlazadaAccesos::insertar",
+        [](size_t) { return make_unique<ListaEnlazadaAccesos>(); },
+        [](auto& lista, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                lista->insertar(nombreUsuario(i), horaBase + static_cast<time_t>(i), 1);
+            }
+            return n;
+        });
+
+    // peor caso: el usuario buscado es el ultimo de la lista
+    arnes.ejecutar("ListaEnlazadaAccesos::buscarPorNombre",
+        [](size_t n) { return crearLista(n, n); },
+        [](auto& lista, size_t n) {
+            const string objetivo = nombreUsuario(n - 1);
+            for (int i = 0; i < 5; ++i) noOptimizar(lista->buscarPorNombre(objetivo));
+            return size_t{5};
+        });
+
+    arnes.ejecutar("ListaEnlazadaAccesos::buscarPorHora",
+        [](size_t n) { return crearLista(n, n); },
+        [](auto& lista, size_t n) {
+            for (int i = 0; i < 5; ++i) noOptimizar(lista->buscarPorHora(horaBase + static_cast<time_t>(n - 1)));
+            return size_t{5};
+        });
+}
+
+void benchmarksActividades(ArnesBenchmarks& arnes) {
+    arnes.ejecutar("ColaActividades::enqueue",
+        [](size_t) { return make_unique<ColaActividades>(); },
+        [](auto& cola, size_t n) {
+            for (size_t i = 0; i < n; ++i) cola->enqueue(nombreUsuario(i % 1000), actividadesPrueba[i % 4]);
+            return n;
+        });
+
+    // el mismo trabajo que enqueue pero en lotes de 1000
+    arnes.ejecutar("ColaActividades::enqueueLote",
+        [](size_t n) {
+            vector<SolicitudActividad> solicitudes(n);
+            for (size_t i = 0; i < n; ++i) {
+                solicitudes[i] = {nombreUsuario(i % 1000), CatalogoActividades::idPredefinida(i % 4)};
+            }
+            return make_pair(make_unique<ColaActividades>(), std::move(solicitudes));
+        },
+        [](auto& estado, size_t n) {
+            span<const SolicitudActividad> todas(estado.second);
+            for (size_t i = 0; i < n; i += 1000) estado.first->enqueueLote(todas.subspan(i, min<size_t>(1000, n - i)));
+            return n;
+        });
+
+    // modo durable: cada lote de 1000 espera a una sola sincronizacion del diario
+    arnes.ejecutar("ColaActividades::enqueueLote (durable)",
+        [](size_t n) {
+            string ruta = (filesystem::temp_directory_path() / "tgpel_benchmark.wal").string();
+            filesystem::remove(ruta);
+            filesystem::remove(ruta + ".ckp");
+            auto cola = make_unique<ColaActividades>();
+            ConfiguracionDiario configuracion;
+            configuracion.ruta = ruta;
+            cola->activarDurabilidad(configuracion);
+            vector<SolicitudActividad> solicitudes(n);
+            for (size_t i = 0; i < n; ++i) {
+                solicitudes[i] = {nombreUsuario(i % 1000), CatalogoActividades::idPredefinida(i % 4)};
+            }
+            return make_pair(std::move(cola), std::move(solicitudes));
+        },
+        [](auto& estado, size_t n) {
+            span<const SolicitudActividad> todas(estado.second);
+            for (size_t i = 0; i < n; i += 1000) estado.first->enqueueLote(todas.subspan(i, min<size_t>(1000, n - i)));
+            return n;
+        });
+
+    arnes.ejecutar("ColaActividades::dequeue",
+        [](size_t n) { return crearCola(n, 1000); },
+        [](auto& cola, size_t n) {
+            for (size_t i = 0; i < n; ++i) cola->dequeue();
+            return n;
+        });
+
+    arnes.ejecutar("ColaActividades::drenar",
+        [](size_t n) { return crearCola(n, 1000); },
+        [](auto& cola, size_t n) {
+            size_t procesadas = 0;
+            while (cola->drenar(1000, [&](const RegistroActividad&) { ++procesadas; })) {}
+            noOptimizar(procesadas);
+            return n;
+        });
+
+    // peor caso: el usuario consultado no tiene actividades
+    arnes.ejecutar("ColaActividades::tieneActividades",
+        [](size_t n) { return crearCola(n, n); },
+        [](auto& cola, size_t) {
+            for (int i = 0; i < 5; ++i) noOptimizar(cola->tieneActividades("sin_actividades"));
+            return size_t{5};
+        });
+
+    // un usuario con dos actividades dentro de una cola de n
+    arnes.ejecutar("ColaActividades::mostrar",
+        [](size_t n) {
+            auto cola = crearCola(n, n);
+            cola->enqueue("objetivo", actividadesPrueba[0]);
+            cola->enqueue("objetivo", actividadesPrueba[1]);
+            return cola;
+        },
+        [](auto& cola, size_t) {
+            for (int i = 0; i < 5; ++i) cola->mostrar("objetivo");
+            return size_t{5};
+        });
+
+    // n actividades con plazos repartidos en la proxima hora; se procesan todos de golpe
+    arnes.ejecutar("ColaActividades::procesarVencimientos",
+        [](size_t n) {
+            auto cola = make_unique<ColaActividades>();
+            time_t ahora = time(0);
+            for (size_t i = 0; i < n; ++i) {
+                cola->enqueue(nombreUsuario(i % 1000), actividadesPrueba[i % 4], ahora + 1 + static_cast<time_t>(i % 3600));
+            }
+            return cola;
+        },
+        [](auto& cola, size_t) {
+            return cola->procesarVencimientos(time(0) + 3601, [](const RegistroActividad&) { return time_t{0}; });
+        });
+}
+
+// filtros por tiempo: recorrido de la lista nodo a nodo frente a las operaciones sobre la
+// columna de horas en cada juego de instrucciones; la ventana cubre la mitad central
+void benchmarksColumnas(ArnesBenchmarks& arnes) {
+    auto ventana = [](size_t n) { return pair<time_t, time_t>{horaBase + static_cast<time_t>(n / 4), horaBase + static_cast<time_t>(3 * n / 4)}; };
+
+    arnes.ejecutar("contar en ventana (lista)",
+        [](size_t n) { return crearLista(n, 1000); },
+        [&](auto& lista, size_t n) {
+            auto [desde, hasta] = ventana(n);
+            size_t total = 0;
+            for (const NodoAcceso* nodo = lista->getCabeza(); nodo; nodo = nodo->siguiente) {
+                total += nodo->horaAcceso >= desde && nodo->horaAcceso < hasta;
+            }
+            noOptimizar(total);
+            return n;
+        });
+
+    struct Variante {
+        const char* nombre;
+        size_t (*contar)(span<const time_t>, time_t, time_t);
+        size_t (*filtrar)(span<const time_t>, time_t, time_t, uint32_t*);
+        pair<time_t, time_t> (*extremos)(span<const time_t>);
+    };
+    vector<Variante> variantes = {{"escalar", contarEnRangoEscalar, filtrarEnRangoEscalar, minimoMaximoEscalar}};
+#ifdef COLUMNAS_SIMD_X86
+    if (detectarNivelSimd() >= NivelSimd::Sse42) variantes.push_back({"sse4.2", contarEnRangoSse42, filtrarEnRangoSse42, minimoMaximoSse42});
+    if (detectarNivelSimd() >= NivelSimd::Avx2) variantes.push_back({"avx2", contarEnRangoAvx2, filtrarEnRangoAvx2, minimoMaximoAvx2});
+#endif
+    for (const Variante& variante : variantes) {
+        arnes.ejecutar(string("contarEnRango (") + variante.nombre + ")", crearColumnaHoras,
+            [&](auto& horas, size_t n) {
+                auto [desde, hasta] = ventana(n);
+                noOptimizar(variante.contar(*horas, desde, hasta));
+                return n;
+            });
+        arnes.ejecutar(string("filtrarEnRango (") + variante.nombre + ")",
+            [](size_t n) { return make_unique<pair<vector<time_t>, vector<uint32_t>>>(std::move(*crearColumnaHoras(n)), vector<uint32_t>(n)); },
+            [&](auto& datos, size_t n) {
+                auto [desde, hasta] = ventana(n);
+                noOptimizar(variante.filtrar(datos->first, desde, hasta, datos->second.data()));
+                return n;
+            });
+        arnes.ejecutar(string("minimoMaximo (") + variante.nombre + ")", crearColumnaHoras,
+            [&](auto& horas, size_t n) {
+                noOptimizar(variante.extremos(*horas));
+                return n;
+            });
+    }
+}
+
+// agregaciones con n claves distintas: arbol, tabla con un nodo por clave y tabla plana.
+// El JSON incluye las reservas de memoria de cada medicion
+void benchmarksAgregaciones(ArnesBenchmarks& arnes) {
+    arnes.ejecutar("conteo por usuario (map)", crearNombres,
+        [](auto& nombres, size_t) { return contarNombres<map<string, int>>(*nombres); });
+    arnes.ejecutar("conteo por usuario (unordered_map)", crearNombres,
+        [](auto& nombres, size_t) { return contarNombres<unordered_map<string, int>>(*nombres); });
+    arnes.ejecutar("conteo por usuario (TablaHashPlana)", crearNombres,
+        [](auto& nombres, size_t) { return contarNombres<TablaHashPlana<string, int>>(*nombres); });
+
+    // pares (usuario, actividad): mapas anidados por nombre frente a una clave compuesta de ids
+    arnes.ejecutar("conteo por par (map anidado)",
+        [](size_t n) {
+            auto pares = make_unique<vector<pair<string, string>>>(n);
+            for (size_t i = 0; i < n; ++i) (*pares)[i] = {nombreUsuario(i / 4), actividadesPrueba[i % 4]};
+            return pares;
+        },
+        [](auto& pares, size_t) {
+            map<string, map<string, int>> conteos;
+            for (int vuelta = 0; vuelta < 2; ++vuelta) {
+                for (const auto& [usuario, actividad] : *pares) conteos[usuario][actividad]++;
+            }
+            noOptimizar(conteos.size());
+            return 2 * pares->size();
+        });
+    arnes.ejecutar("conteo por par (unordered_map)",
+        [](size_t n) { return make_unique<size_t>(n); },
+        [](auto&, size_t n) { return contarPares<unordered_map<uint64_t, int>>(n); });
+    arnes.ejecutar("conteo por par (TablaHashPlana)",
+        [](size_t n) { return make_unique<size_t>(n); },
+        [](auto&, size_t n) { return contarPares<TablaHashPlana<uint64_t, int>>(n); });
+}
+
+void benchmarksAnalisis(ArnesBenchmarks& arnes) {
+    // con un numero fijo de usuarios el informe debe costar lo mismo para cualquier tamaño del registro
+    arnes.ejecutar("generarEstadisticasAccesos",
+        [](size_t n) { return crearLista(n, 1000); },
+        [](auto& lista, size_t) {
+            generarEstadisticasAccesos(*lista);
+            return size_t{1};
+        });
+
+    // una asignacion por segundo con un millon de pares distintos: la ventana se desliza
+    // continuamente y su memoria queda acotada
+    arnes.ejecutar("DetectorSospechosas::registrar",
+        [](size_t) { return make_unique<DetectorSospechosas>(); },
+        [](auto& detector, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                detector->registrar(static_cast<uint32_t>(i % 1000000), static_cast<uint32_t>(i % 4), horaBase + static_cast<time_t>(i));
+            }
+            return n;
+        });
+
+    // un usuario distinto por acceso: el modo exacto crece con los usuarios y el aproximado no
+    arnes.ejecutar("generarEstadisticasAccesos (exacto, usuarios distintos)",
+        [](size_t n) { return crearLista(n, n); },
+        [](auto& lista, size_t) {
+            generarEstadisticasAccesos(*lista);
+            return size_t{1};
+        });
+
+    arnes.ejecutar("generarEstadisticasAccesos (aproximado, usuarios distintos)",
+        [](size_t n) { return crearLista(n, n, ModoEstadisticas::Aproximado); },
+        [](auto& lista, size_t) {
+            generarEstadisticasAccesos(*lista);
+            return size_t{1};
+        });
+
+    // n accesos repartidos en 30 dias entre 100000 usuarios; consulta ventanas de una semana
+    arnes.ejecutar("DistintosPorPeriodo::estimar (7 dias)",
+        [](size_t n) {
+            auto distintos = make_unique<DistintosPorPeriodo>();
+            for (size_t i = 0; i < n; ++i) {
+                distintos->registrar(nombreUsuario(i % 100000), horaBase + static_cast<time_t>(i * (30 * 86400) / n));
+            }
+            return distintos;
+        },
+        [](auto& distintos, size_t) {
+            for (int i = 0; i < 10; ++i) {
+                time_t fin = horaBase + 30 * 86400 - i * 3600;
+                noOptimizar(distintos->estimar(fin - 7 * 86400, fin));
+            }
+            return size_t{10};
+        });
+
+    // n accesos repartidos en 180 dias; cuenta los de los ultimos 90 dias por perfil
+    arnes.ejecutar("AcumuladosAccesos::contar (90 dias)",
+        [](size_t n) {
+            auto acumulados = make_unique<AcumuladosAccesos>();
+            for (size_t i = 0; i < n; ++i) {
+                acumulados->registrar(1 + static_cast<int>(i % 3), horaBase + static_cast<time_t>(i * (180 * 86400) / n));
+            }
+            return acumulados;
+        },
+        [](auto& acumulados, size_t) {
+            time_t fin = horaBase + 180 * 86400;
+            for (int perfil = 0; perfil < 4; ++perfil) noOptimizar(acumulados->contar(fin - 90 * 86400 + 1234, fin, perfil));
+            return size_t{4};
+        });
+
+    // exportaciones de n filas; cada operacion es un byte escrito, asi que 1 / ns_por_operacion
+    // da los GB/s
+    const string rutaExportacion = (filesystem::temp_directory_path() / "tgpel_benchmark.exp").string();
+    for (FormatoExportacion formato : {FormatoExportacion::Csv, FormatoExportacion::Columnar}) {
+        const char* nombreFormato = formato == FormatoExportacion::Csv ? "csv" : "columnar";
+        arnes.ejecutar(string("exportarAccesos (") + nombreFormato + ", bytes)",
+            [](size_t n) { return crearLista(n, 1000); },
+            [&, formato](auto& lista, size_t) { return exportarAccesos(*lista, rutaExportacion, formato).bytes; });
+        arnes.ejecutar(string("exportarActividades (") + nombreFormato + ", bytes)",
+            [](size_t n) { return crearCola(n, 1000); },
+            [&, formato](auto& cola, size_t) { return exportarActividades(*cola, rutaExportacion, formato).bytes; });
+    }
+    filesystem::remove(rutaExportacion);
+
+    arnes.ejecutar("generarInformeSospechosas",
+        [](size_t n) { return crearDetector(n); },
+        [](auto& detector, size_t) {
+            generarInformeSospechosas(*detector, horaBase);
+            return size_t{1};
+        });
+}
+
+// -----FUNCION PRINCIPAL-----
+// uso: benchmarks [max_elementos] [archivo_json]
+int main(int argc, char* argv[]) {
+    size_t maxElementos = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000; // 10^7 por defecto
+    string archivoSalida = argc > 2 ? argv[2] : "resultados_benchmarks.json";
+
+    ArnesBenchmarks arnes(maxElementos, 10.0); // presupuesto de 10 segundos por medicion
+    benchmarksAccesos(arnes);
+    benchmarksActividades(arnes);
+    benchmarksColumnas(arnes);
+    benchmarksAgregaciones(arnes);
+    benchmarksAnalisis(arnes);
+
+    ofstream archivo(archivoSalida);
+    arnes.escribirJson(archivo);
+    arnes.escribirJson(cout);
+    return 0;
+}
@@ -0,0 +1,497 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "accesos.h"
+#include "actividades.h"
+#include "consultas.h"
+#include "diario.h"
+#include "incremental.h"
+#include "seguridad.h"
+#include "tabla_hash.h"
+using namespace std;
+
+// -----VERIFICACIONES-----
+// compara las estructuras con indices y el diario con una version de fuerza bruta sobre
+// datos aleatorios con semilla fija. Muestra cada discrepancia y termina con codigo 1 si
+// hubo alguna
+
+// las sesiones interactivas se definen en main.cpp; las consultas solo necesitan los
+// nombres de los perfiles
+void PerfilUsuario::sesion(ListaEnlazadaAccesos&, ColaActividades&, NodoAcceso*, const string&, PilaSeguridad&) {}
+void PerfilSupervisor::sesion(ListaEnlazadaAccesos&, ColaActividades&, NodoAcceso*, const string&, PilaSeguridad&) {}
+void PerfilAnalista::sesion(ListaEnlazadaAccesos&, ColaActividades&, NodoAcceso*, const string&, PilaSeguridad&) {}
+
+int fallos = 0; // comprobaciones fallidas
+
+void comprobar(bool condicion, const string& descripcion) {
+    if (condicion) return;
+    ++fallos;
+    cout << "Error: " << descripcion << endl;
+}
+
+// silencia cout mientras existe, para las inserciones que muestran mensajes
+class Silencio {
+    streambuf* anterior;
+
+public:
+    Silencio() : anterior(cout.rdbuf(nullptr)) {}
+    ~Silencio() {
+        cout.rdbuf(anterior);
+    }
+};
+
+// -----TABLA HASH PLANA-----
+// inserciones y borrados aleatorios contra unordered_map; los rangos de claves pequeños
+// llenan grupos contiguos y ejercitan el desplazamiento hacia atras de borrar
+template <typename Clave, typename Generar>
+void verificarTablaHash(const string& nombre, Generar generar) {
+    mt19937_64 aleatorio(1);
+    for (int ronda = 0; ronda < 10; ++ronda) {
+        TablaHashPlana<Clave, int> tabla;
+        unordered_map<Clave, int> referencia;
+        uint64_t rango = 50 + ronda * 400;
+        for (int i = 0; i < 100000; ++i) {
+            Clave clave = generar(aleatorio() % rango);
+            if (aleatorio() % 3) {
+                tabla[clave] += 1;
+                referencia[clave] += 1;
+            } else {
+                comprobar(tabla.borrar(clave) == (referencia.erase(clave) > 0), nombre + ": borrar no coincide");
+            }
+            if (i % 1000) continue;
+            comprobar(tabla.size() == referencia.size(), nombre + ": el tamaño no coincide");
+            for (const auto& [k, v] : referencia) {
+                const int* valor = tabla.buscar(k);
+                comprobar(valor && *valor == v, nombre + ": falta una clave o su valor");
+            }
+            size_t visitadas = 0;
+            tabla.recorrer([&](const Clave& k, int v) {
+                auto encontrada = referencia.find(k);
+                comprobar(encontrada != referencia.end() && encontrada->second == v, nombre + ": recorrer da una clave de mas");
+                ++visitadas;
+            });
+            comprobar(visitadas == referencia.size(), nombre + ": recorrer no visita todas las claves");
+        }
+        tabla.limpiar();
+        comprobar(tabla.empty() && !tabla.contiene(generar(3)), nombre + ": limpiar deja claves");
+    }
+}
+
+// -----COLUMNA DE HORAS-----
+// filtrado por bloques en tamaños alrededor del bloque
+void verificarFiltroPorHora() {
+    mt19937 aleatorio(3);
+    for (size_t filas : {0, 1, 4095, 4096, 4097, 12289}) {
+        ListaEnlazadaAccesos accesos;
+        {
+            Silencio silencio;
+            for (size_t i = 0; i < filas; ++i) accesos.insertar("u" + to_string(aleatorio() % 9), 1000 + aleatorio() % 500, 1);
+        }
+        span<const time_t> columna = accesos.getColumnaHoras();
+        vector<time_t> esperadas;
+        for (time_t hora : columna) {
+            if (hora >= 1100 && hora < 1300) esperadas.push_back(hora);
+        }
+        vector<time_t> obtenidas;
+        for (const NodoAcceso* nodo : accesos.filtrarPorHora(1100, 1300)) obtenidas.push_back(nodo->horaAcceso);
+        comprobar(obtenidas == esperadas, "filtrarPorHora con " + to_string(filas) + " filas");
+    }
+}
+
+// -----CREDENCIALES-----
+// las credenciales mas largas que la capacidad en linea se guardan aparte y siguen validando
+void verificarCredencialesLargas() {
+    ListaEnlazadaAccesos accesos;
+    string contrasenaLarga(40, 'x');
+    contrasenaLarga[39] = 'y';
+    string telefonoLargo = "+34 600 000 000 ext. 1234";
+    {
+        Silencio silencio;
+        accesos.insertar("supervisora", 1000, 2, contrasenaLarga);
+        accesos.insertar("analista", 2000, 3, contrasenaLarga, telefonoLargo);
+        accesos.insertar("corto", 3000, 2, "clave");
+    }
+    NodoAcceso* nodo = accesos.buscarPorNombre("supervisora");
+    comprobar(nodo && nodo->contrasena.enBloque() && nodo->contrasena == contrasenaLarga, "la contraseña de 40 caracteres no se guardo entera");
+    comprobar(!accesos.buscarPorNombre("corto")->contrasena.enBloque(), "una contraseña corta no esta en linea");
+    bool correcta, incorrecta, analista, telefonoErroneo;
+    {
+        Silencio silencio;
+        correcta = accesos.validarCredenciales("supervisora", contrasenaLarga);
+        incorrecta = accesos.validarCredenciales("supervisora", contrasenaLarga.substr(0, 39) + "x");
+        analista = accesos.validarCredenciales("analista", contrasenaLarga, telefonoLargo);
+        telefonoErroneo = accesos.validarCredenciales("analista", contrasenaLarga, telefonoLargo + "5");
+    }
+    comprobar(correcta, "la contraseña de 40 caracteres no valida el inicio de sesion");
+    comprobar(!incorrecta, "valida una contraseña larga distinta");
+    comprobar(analista && !telefonoErroneo, "el telefono largo no se compara entero");
+
+    CadenaFija<maxContrasena> original, copia;
+    original.asignar(contrasenaLarga);
+    copia = original;
+    copia.asignar(copia.vista().substr(1)); // se asigna una parte de si misma
+    comprobar(original == contrasenaLarga && copia == contrasenaLarga.substr(1), "copiar una cadena en bloque la comparte");
+    copia.asignar(copia.vista().substr(0, 5));
+    comprobar(!copia.enBloque() && copia == "xxxxx", "una cadena que vuelve a caber no vuelve a linea");
+}
+
+// -----CONSULTAS-----
+// consultas aleatorias sobre accesos; cada plan del planificador debe dar lo mismo que
+// filtrar todos los accesos
+void verificarConsultasAccesos(ModoEstadisticas modo) {
+    mt19937 aleatorio(7);
+    ListaEnlazadaAccesos accesos(modo);
+    struct Acceso {
+        string usuario;
+        time_t hora;
+        int perfil;
+    };
+    vector<Acceso> todos;
+    time_t base = 1700006400 - 1700006400 % 86400;
+    {
+        Silencio silencio;
+        for (int i = 0; i < 20000; ++i) {
+            Acceso acceso{"u" + to_string(aleatorio() % 50), base + static_cast<time_t>(aleatorio() % (10 * 86400)), 1 + static_cast<int>(aleatorio() % 4)};
+            accesos.insertar(acceso.usuario, acceso.hora, acceso.perfil);
+            todos.push_back(acceso);
+        }
+    }
+
+    map<string, int> planes;
+    for (int i = 0; i < 3000; ++i) {
+        Consulta consulta;
+        consulta.usuario = aleatorio() % 2 ? "u" + to_string(aleatorio() % 60) : "";
+        consulta.perfil = aleatorio() % 2 ? static_cast<int>(aleatorio() % 5) : 0;
+        switch (aleatorio() % 4) {
+            case 1: // dias completos, que los acumulados cubren sin leer filas
+                consulta.desde = base + static_cast<time_t>(aleatorio() % 10) * 86400;
+                consulta.hasta = consulta.desde + 86400 * static_cast<time_t>(1 + aleatorio() % 3);
+                break;
+            case 2:
+                consulta.desde = base + static_cast<time_t>(aleatorio() % (10 * 86400));
+                break;
+            case 3:
+                consulta.hasta = base + static_cast<time_t>(aleatorio() % (10 * 86400));
+                break;
+        }
+        consulta.agregacion = static_cast<AgregacionConsulta>(aleatorio() % 4);
+        consulta.limite = 5;
+        ResultadoConsulta resultado = consultarAccesos(consulta, accesos);
+        string plan = resultado.plan.describir();
+        planes[plan]++;
+
+        uint64_t esperado = 0;
+        map<string, uint64_t> grupos;
+        for (const Acceso& acceso : todos) {
+            if (!consulta.usuario.empty() && acceso.usuario != consulta.usuario) continue;
+            if (consulta.perfil && acceso.perfil != consulta.perfil) continue;
+            if (acceso.hora < consulta.desde || (consulta.hasta && acceso.hora >= consulta.hasta)) continue;
+            ++esperado;
+            grupos[consulta.agregacion == AgregacionConsulta::PorUsuario ? acceso.usuario : nombrePerfilConsulta(acceso.perfil)]++;
+        }
+        comprobar(resultado.total == esperado, "consulta de accesos con plan '" + plan + "': total " + to_string(resultado.total)
+                                                   + ", esperado " + to_string(esperado));
+        if (consulta.agregacion == AgregacionConsulta::PorUsuario || consulta.agregacion == AgregacionConsulta::PorPerfil) {
+            comprobar(resultado.grupos == vector<pair<string, uint64_t>>(grupos.begin(), grupos.end()), "grupos de accesos con plan '" + plan + "'");
+        }
+        if (consulta.agregacion == AgregacionConsulta::Listar) {
+            comprobar(resultado.filas.size() == min<uint64_t>(consulta.limite, esperado), "filas de accesos con plan '" + plan + "'");
+        }
+    }
+    cout << "Planes de accesos (" << (modo == ModoEstadisticas::Exacto ? "exacto" : "aproximado") << "):" << endl;
+    for (const auto& [plan, veces] : planes) cout << "  " << veces << " " << plan << endl;
+}
+
+// consultas aleatorias sobre las actividades pendientes
+void verificarConsultasActividades() {
+    mt19937 aleatorio(3);
+    ColaActividades cola;
+    const string actividades[] = {"a1", "a2", "a3"};
+    deque<pair<string, string>> pendientes; // (usuario normalizado, actividad)
+    for (int i = 0; i < 3000; ++i) {
+        string usuario = "U" + to_string(aleatorio() % 30);
+        const string& actividad = actividades[aleatorio() % 3];
+        cola.enqueue(usuario, actividad);
+        pendientes.emplace_back(toLowerCase(usuario), actividad);
+    }
+    {
+        Silencio silencio;
+        for (int i = 0; i < 500; ++i) {
+            cola.dequeue();
+            pendientes.pop_front();
+        }
+    }
+
+    map<string, int> planes;
+    for (int i = 0; i < 2000; ++i) {
+        Consulta consulta;
+        consulta.fuente = FuenteConsulta::Actividades;
+        consulta.usuario = aleatorio() % 2 ? "U" + to_string(aleatorio() % 35) : "";
+        consulta.actividad = aleatorio() % 2 ? actividades[aleatorio() % 3] : "";
+        consulta.agregacion = static_cast<AgregacionConsulta>(aleatorio() % 5);
+        ResultadoConsulta resultado = consultarActividades(consulta, cola);
+        string plan = resultado.plan.describir();
+        planes[plan]++;
+
+        uint64_t esperado = 0;
+        map<string, uint64_t> grupos;
+        for (const auto& [usuario, actividad] : pendientes) {
+            if (!consulta.usuario.empty() && usuario != toLowerCase(consulta.usuario)) continue;
+            if (!consulta.actividad.empty() && actividad != consulta.actividad) continue;
+            ++esperado;
+            grupos[consulta.agregacion == AgregacionConsulta::PorUsuario ? usuario : actividad]++;
+        }
+        comprobar(resultado.total == esperado, "consulta de actividades con plan '" + plan + "': total " + to_string(resultado.total)
+                                                   + ", esperado " + to_string(esperado));
+        if (consulta.agregacion == AgregacionConsulta::PorUsuario || consulta.agregacion == AgregacionConsulta::PorActividad) {
+            comprobar(resultado.grupos == vector<pair<string, uint64_t>>(grupos.begin(), grupos.end()), "grupos de actividades con plan '" + plan + "'");
+        }
+    }
+    cout << "Planes de actividades:" << endl;
+    for (const auto& [plan, veces] : planes) cout << "  " << veces << " " << plan << endl;
+}
+
+// -----DIARIO-----
+using ContenidoCola = vector<tuple<string, string, time_t, time_t>>; // usuario, actividad, hora y vencimiento
+
+ContenidoCola contenido(const ColaActividades& cola) {
+    ContenidoCola filas;
+    for (size_t i = 0; i < cola.tamano(); ++i) {
+        const RegistroActividad& registro = cola.en(i);
+        filas.emplace_back(registro.getUsuario(), registro.getActividad(), registro.hora, cola.getVencimiento(registro));
+    }
+    return filas;
+}
+
+// operaciones aleatorias sobre una cola durable; con puntos de control frecuentes y el
+// descarte de las mas antiguas, el diario mezcla encolados, desencolados y truncados
+void operarCola(ColaActividades& cola, mt19937& aleatorio, int operaciones) {
+    Silencio silencio;
+    for (int i = 0; i < operaciones; ++i) {
+        string usuario = "u" + to_string(aleatorio() % 20);
+        time_t vencimiento = aleatorio() % 2 ? time(0) + 60 * static_cast<time_t>(1 + aleatorio() % 100) : 0;
+        switch (aleatorio() % 6) {
+            case 0:
+                cola.dequeue();
+                break;
+            case 1:
+                cola.drenar(aleatorio() % 4, [](const RegistroActividad&) {});
+                break;
+            case 2: {
+                vector<SolicitudActividad> lote;
+                for (int j = 0; j < 5; ++j) lote.push_back({usuario, CatalogoActividades::idPredefinida(j % 4), vencimiento});
+                ResultadoLote resultado = cola.enqueueLote(lote);
+                comprobar(resultado.aceptadas == lote.size() && resultado.durable, "el lote no entro entero en la cola durable");
+                break;
+            }
+            default:
+                cola.enqueue(usuario, "actividad " + to_string(aleatorio() % 7), vencimiento);
+        }
+    }
+}
+
+// la cola recuperada del diario debe ser igual a la que lo escribio, tambien con basura al final
+void verificarRecuperacionDiario() {
+    filesystem::path carpeta = filesystem::temp_directory_path() / "tgpel_verificaciones";
+    filesystem::remove_all(carpeta);
+    filesystem::create_directories(carpeta);
+    ConfiguracionDiario configuracion;
+    configuracion.ruta = (carpeta / "actividades.wal").string();
+    configuracion.esperarConfirmacion = false; // la recuperacion no depende de esperar a cada fsync
+    configuracion.bytesParaPuntoControl = 16 << 10;
+
+    mt19937 aleatorio(11);
+    ContenidoCola esperado;
+    for (int ronda = 0; ronda < 4; ++ronda) {
+        ColaActividades cola;
+        comprobar(cola.activarDurabilidad(configuracion), "no se pudo activar el diario en la ronda " + to_string(ronda));
+        comprobar(contenido(cola) == esperado, "la cola recuperada no coincide en la ronda " + to_string(ronda));
+        cola.limitar({60, PoliticaDesborde::DescartarAntigua});
+        operarCola(cola, aleatorio, 1500);
+        esperado = contenido(cola);
+        if (ronda == 2) { // la proxima recuperacion debe ignorar un registro a medias
+            ofstream diario(configuracion.ruta, ios::binary | ios::app);
+            diario << "registro incompleto";
+        }
+    }
+    filesystem::remove_all(carpeta);
+}
+
+string leerArchivo(const filesystem::path& ruta) {
+    ifstream archivo(ruta, ios::binary);
+    return string(istreambuf_iterator<char>(archivo), istreambuf_iterator<char>());
+}
+
+void escribirArchivo(const filesystem::path& ruta, const string& datos) {
+    ofstream archivo(ruta, ios::binary | ios::trunc);
+    archivo << datos;
+}
+
+// recupera una cola del punto de control de origen y del diario indicado, en su propia carpeta
+ContenidoCola recuperarCopia(const filesystem::path& carpeta, const filesystem::path& puntoControl, const string& diario) {
+    filesystem::create_directories(carpeta);
+    filesystem::copy_file(puntoControl, carpeta / "actividades.wal.ckp", filesystem::copy_options::overwrite_existing);
+    escribirArchivo(carpeta / "actividades.wal", diario);
+    ConfiguracionDiario configuracion;
+    configuracion.ruta = (carpeta / "actividades.wal").string();
+    configuracion.esperarConfirmacion = false;
+    ColaActividades cola;
+    comprobar(cola.activarDurabilidad(configuracion), "no se pudo recuperar la copia de " + carpeta.string());
+    return contenido(cola);
+}
+
+// un registro que falta en medio del diario detiene la recuperacion en ese punto, igual que
+// si el diario acabara ahi, y una cabecera rota con una longitud enorme se ignora
+void verificarHuecoDiario() {
+    filesystem::path carpeta = filesystem::temp_directory_path() / "tgpel_verificaciones_hueco";
+    filesystem::remove_all(carpeta);
+    filesystem::create_directories(carpeta / "original");
+    ConfiguracionDiario configuracion;
+    configuracion.ruta = (carpeta / "original" / "actividades.wal").string();
+    configuracion.esperarConfirmacion = false;
+
+    mt19937 aleatorio(5);
+    ContenidoCola completo;
+    {
+        ColaActividades cola;
+        comprobar(cola.activarDurabilidad(configuracion), "no se pudo activar el diario del hueco");
+        operarCola(cola, aleatorio, 600);
+        completo = contenido(cola);
+    }
+
+    // cabecera: lsn, tipo, longitud y suma de control, seguidos de la carga
+    constexpr size_t bytesCabecera = sizeof(uint64_t) + sizeof(uint8_t) + 2 * sizeof(uint32_t);
+    string diario = leerArchivo(configuracion.ruta);
+    vector<size_t> inicios;
+    uint64_t ultimoLsn = 0;
+    for (size_t posicion = 0; posicion + bytesCabecera <= diario.size();) {
+        uint32_t longitud;
+        memcpy(&ultimoLsn, diario.data() + posicion, sizeof(ultimoLsn));
+        memcpy(&longitud, diario.data() + posicion + sizeof(uint64_t) + sizeof(uint8_t), sizeof(longitud));
+        inicios.push_back(posicion);
+        posicion += bytesCabecera + longitud;
+    }
+    comprobar(inicios.size() > 10, "el diario del hueco tiene muy pocos registros");
+    if (inicios.size() <= 10) return;
+    filesystem::path puntoControl = configuracion.ruta + ".ckp";
+
+    size_t hueco = inicios.size() / 2;
+    string sinRegistro = diario.substr(0, inicios[hueco]) + diario.substr(inicios[hueco + 1]);
+    ContenidoCola conHueco = recuperarCopia(carpeta / "hueco", puntoControl, sinRegistro);
+    ContenidoCola truncado = recuperarCopia(carpeta / "truncado", puntoControl, diario.substr(0, inicios[hueco]));
+    comprobar(conHueco == truncado, "la recuperacion sigue despues de un hueco de lsn");
+
+    string cabeceraRota(bytesCabecera, '\0');
+    uint64_t siguiente = ultimoLsn + 1;
+    uint8_t tipo = DiarioActividades::Encolado;
+    uint32_t longitud = 0xfffffff0u;
+    memcpy(cabeceraRota.data(), &siguiente, sizeof(siguiente));
+    memcpy(cabeceraRota.data() + sizeof(uint64_t), &tipo, sizeof(tipo));
+    memcpy(cabeceraRota.data() + sizeof(uint64_t) + sizeof(uint8_t), &longitud, sizeof(longitud));
+    comprobar(recuperarCopia(carpeta / "rota", puntoControl, diario + cabeceraRota) == completo,
+              "una cabecera rota cambia la cola recuperada");
+    filesystem::remove_all(carpeta);
+}
+
+// -----ESTADO DE LOS INFORMES INCREMENTALES-----
+// los textos con tabuladores o saltos de linea sobreviven a guardar y cargar, y un estado
+// roto se rechaza sin excepciones
+void verificarEstadoIncremental() {
+    filesystem::path ruta = filesystem::temp_directory_path() / "tgpel_verificaciones_estado.txt";
+    EstadoIncremental estado;
+    estado.cursor = 1700000000;
+    estado.lista = 7;
+    estado.posicion = 3;
+    estado.accesos["ana\tlopez\\"] = 4;
+    estado.actividades[{"juan", "Revisar\nel informe\t\r"}] = 2;
+    comprobar(estado.guardar(ruta.string()), "no se pudo guardar el estado incremental");
+    EstadoIncremental cargado;
+    bool correcto = cargado.cargar(ruta.string());
+    comprobar(correcto && cargado.cursor == estado.cursor && cargado.lista == estado.lista && cargado.posicion == estado.posicion
+                  && cargado.accesos == estado.accesos && cargado.actividades == estado.actividades,
+              "el estado incremental cambia al guardarlo y cargarlo");
+
+    for (const char* roto : {"cursor\t12x\n", "cursor\t\n", "acceso\tana\n", "acceso\tana\t-1\n", "actividad\ta\tb\tc\td\n",
+                             "acceso\tana\\q\t3\n", "posicion\t99999999999999999999999\n"}) {
+        escribirArchivo(ruta, roto);
+        comprobar(!cargado.cargar(ruta.string()) && cargado.accesos.empty(), string("se acepto un estado roto: ") + roto);
+    }
+    filesystem::remove(ruta);
+}
+
+// -----USUARIOS DISTINTOS POR PERIODO-----
+// dos años de accesos con tres usuarios nuevos por dia: los dias fuera de la retencion se
+// pliegan sin perder usuarios y una ventana sin limites se recorta a los dias guardados
+void verificarDistintosPorPeriodo() {
+    DistintosPorPeriodo distintos;
+    constexpr int64_t numDias = 730;
+    for (int64_t d = 0; d < numDias; ++d) {
+        for (int k = 0; k < 3; ++k) distintos.registrar("u" + to_string(d * 3 + k), d * DistintosPorPeriodo::segundosDia + k * 3600);
+    }
+    auto cerca = [](double estimacion, double exacto) { return abs(estimacion - exacto) <= 4 * HyperLogLog::errorRelativo() * exacto; };
+    comprobar(cerca(distintos.estimarTotal(), numDias * 3), "el total de usuarios distintos pierde los dias plegados");
+    comprobar(cerca(distintos.estimar(numeric_limits<time_t>::min() / 2, numeric_limits<time_t>::max()), numDias * 3),
+              "la ventana sin limites no cuenta todo el historial");
+    time_t ultimoDia = (numDias - 1) * DistintosPorPeriodo::segundosDia;
+    comprobar(cerca(distintos.estimar(ultimoDia - 29 * DistintosPorPeriodo::segundosDia, ultimoDia + DistintosPorPeriodo::segundosDia), 30 * 3),
+              "la ventana de los ultimos 30 dias no coincide");
+}
+
+// -----CONTEXTO DE SEGURIDAD-----
+// cada peticion apila su nivel solo si la sesion lo alcanza y deja la pila como estaba
+void verificarContextoSeguridad() {
+    PilaSeguridad pila;
+    pila.ajustarNivel(PerfilSupervisor::id);
+    int tamano = pila.getTamano();
+    {
+        ContextoSeguridad contexto(pila, NivelSeguridad::Alto);
+        comprobar(!contexto.permitido(), "un supervisor obtiene el nivel alto");
+        comprobar(pila.getTamano() == tamano, "una peticion rechazada modifica la pila");
+    }
+    {
+        ContextoSeguridad contexto(pila, NivelSeguridad::Bajo);
+        comprobar(contexto.permitido() && pila.peek() == NivelSeguridad::Bajo, "la peticion de nivel bajo no queda en la cima");
+    }
+    comprobar(pila.getTamano() == tamano && pila.peek() == NivelSeguridad::Medio, "la pila no recupera el nivel de la sesion");
+    for (int i = 0; i < 2 * PilaSeguridad::capacidad; ++i) { // muchas peticiones seguidas no agotan la pila
+        ContextoSeguridad contexto(pila, NivelSeguridad::Medio);
+        if (!contexto.permitido()) {
+            comprobar(false, "la pila se agota tras varias peticiones");
+            break;
+        }
+    }
+}
+
+int main() {
+    verificarTablaHash<uint64_t>("TablaHashPlana<uint64_t>", [](uint64_t k) { return k; });
+    verificarTablaHash<string>("TablaHashPlana<string>", [](uint64_t k) { return to_string(k); });
+    verificarFiltroPorHora();
+    verificarCredencialesLargas();
+    verificarConsultasAccesos(ModoEstadisticas::Exacto);
+    verificarConsultasAccesos(ModoEstadisticas::Aproximado);
+    verificarConsultasActividades();
+    verificarRecuperacionDiario();
+    verificarHuecoDiario();
+    verificarEstadoIncremental();
+    verificarDistintosPorPeriodo();
+    verificarContextoSeguridad();
+
+    if (fallos) {
+        cout << "Error: " << fallos << " comprobaciones fallaron." << endl;
+        return 1;
+    }
+    cout << "Verificaciones correctas." << endl;
+    return 0;
+}
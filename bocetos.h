@@ -0,0 +1,346 @@
+#ifndef BOCETOS_H
+#define BOCETOS_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// -----BOCETOS DE FRECUENCIA-----
+// Count-Min: estima cuantas veces aparecio cada clave con memoria fija (profundidad filas
+// de ancho contadores). La estimacion nunca es menor que el valor real y, con probabilidad
+// 1 - e^-profundidad, lo supera como mucho en (e / ancho) * total
+class BocetoCountMin {
+private:
+    size_t ancho; // contadores por fila
+    size_t profundidad; // filas, cada una con su funcion hash
+    vector<uint64_t> contadores; // profundidad * ancho contadores
+    uint64_t total = 0; // eventos registrados
+
+    // posicion en la fila indicada; deriva las funciones hash de un solo hash de 64 bits
+    size_t columna(uint64_t hash, size_t fila) const {
+        uint64_t h1 = hash, h2 = (hash >> 32) | 1;
+        return (h1 + fila * h2) % ancho;
+    }
+
+public:
+    BocetoCountMin(size_t ancho = 2048, size_t profundidad = 4)
+        : ancho(ancho), profundidad(profundidad), contadores(ancho * profundidad) {}
+
+    void registrar(string_view clave, uint64_t veces = 1) {
+        uint64_t hash = std::hash<string_view>{}(clave);
+        for (size_t fila = 0; fila < profundidad; ++fila) contadores[fila * ancho + columna(hash, fila)] += veces;
+        total += veces;
+    }
+
+    uint64_t estimar(string_view clave) const {
+        uint64_t hash = std::hash<string_view>{}(clave);
+        uint64_t minimo = UINT64_MAX;
+        for (size_t fila = 0; fila < profundidad; ++fila) minimo = min(minimo, contadores[fila * ancho + columna(hash, fila)]);
+        return minimo;
+    }
+
+    uint64_t getTotal() const {
+        return total;
+    }
+
+    // sobreestimacion maxima de cualquier clave con la confianza de getConfianza()
+    double errorMaximo() const {
+        return exp(1.0) / ancho * total;
+    }
+
+    // probabilidad de que una estimacion respete errorMaximo()
+    double getConfianza() const {
+        return 1.0 - exp(-static_cast<double>(profundidad));
+    }
+};
+
+// Space-Saving: mantiene las capacidad claves mas frecuentes con memoria fija. Cuando llega
+// una clave nueva y no hay sitio, sustituye a la de menor cuenta y hereda esa cuenta como
+// error; la cuenta real de cada clave esta en [cuenta - error, cuenta] y cualquier clave con
+// mas de total / capacidad apariciones esta garantizada en el resumen
+class EspacioAhorro {
+public:
+    struct Contador {
+        string clave; // clave vigilada
+        uint64_t cuenta; // cota superior de sus apariciones
+        uint64_t error; // sobreestimacion maxima de cuenta
+    };
+
+private:
+    size_t capacidad; // claves vigiladas como maximo
+    vector<Contador> monticulo; // monticulo de minimos por cuenta
+    unordered_map<string, size_t> posiciones; // posicion de cada clave en el monticulo
+    uint64_t total = 0; // eventos registrados
+
+    void intercambiar(size_t a, size_t b) {
+        swap(monticulo[a], monticulo[b]);
+        posiciones[monticulo[a].clave] = a;
+        posiciones[monticulo[b].clave] = b;
+    }
+
+    // recoloca hacia abajo un contador cuya cuenta aumento
+    void hundir(size_t i) {
+        while (true) {
+            size_t menor = i, izquierda = 2 * i + 1, derecha = 2 * i + 2;
+            if (izquierda < monticulo.size() && monticulo[izquierda].cuenta < monticulo[menor].cuenta) menor = izquierda;
+            if (derecha < monticulo.size() && monticulo[derecha].cuenta < monticulo[menor].cuenta) menor = derecha;
+            if (menor == i) return;
+            intercambiar(i, menor);
+            i = menor;
+        }
+    }
+
+    // recoloca hacia arriba un contador recien añadido
+    void flotar(size_t i) {
+        while (i && monticulo[i].cuenta < monticulo[(i - 1) / 2].cuenta) {
+            intercambiar(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+
+public:
+    explicit EspacioAhorro(size_t capacidad = 100) : capacidad(max<size_t>(1, capacidad)) {
+        monticulo.reserve(this->capacidad);
+        posiciones.reserve(this->capacidad);
+    }
+
+    void registrar(const string& clave) {
+        ++total;
+        auto encontrada = posiciones.find(clave);
+        if (encontrada != posiciones.end()) {
+            monticulo[encontrada->second].cuenta++;
+            hundir(encontrada->second);
+        } else if (monticulo.size() < capacidad) {
+            monticulo.push_back({clave, 1, 0});
+            posiciones[clave] = monticulo.size() - 1;
+            flotar(monticulo.size() - 1);
+        } else { // sustituye a la clave con menor cuenta
+            Contador& minimo = monticulo[0];
+            posiciones.erase(minimo.clave);
+            minimo.error = minimo.cuenta;
+            minimo.cuenta++;
+            minimo.clave = clave;
+            posiciones[clave] = 0;
+            hundir(0);
+        }
+    }
+
+    // las k claves con mayor cuenta, de mayor a menor
+    vector<Contador> principales(size_t k) const {
+        vector<Contador> resultado = monticulo;
+        k = min(k, resultado.size());
+        partial_sort(resultado.begin(), resultado.begin() + k, resultado.end(),
+                     [](const Contador& a, const Contador& b) { return a.cuenta > b.cuenta; });
+        resultado.resize(k);
+        return resultado;
+    }
+
+    uint64_t getTotal() const {
+        return total;
+    }
+
+    size_t getCapacidad() const {
+        return capacidad;
+    }
+
+    // error maximo de cualquier cuenta del resumen
+    uint64_t errorMaximo() const {
+        return total / capacidad;
+    }
+};
+
+// estadisticas aproximadas de accesos por usuario en memoria fija: los usuarios mas
+// activos con Space-Saving y la frecuencia de cualquier usuario con Count-Min
+struct EstadisticasAproximadas {
+    EspacioAhorro principales; // usuarios mas activos
+    BocetoCountMin frecuencias; // accesos estimados de cualquier usuario
+
+    EstadisticasAproximadas(size_t capacidadPrincipales = 1000, size_t ancho = 4096, size_t profundidad = 4)
+        : principales(capacidadPrincipales), frecuencias(ancho, profundidad) {}
+
+    void registrar(const string& usuario) {
+        principales.registrar(usuario);
+        frecuencias.registrar(usuario);
+    }
+};
+
+// -----CARDINALIDAD-----
+// HyperLogLog: estima cuantas claves distintas se registraron con 2^bitsIndice registros de
+// un byte (error tipico 1.04 / sqrt(2^bitsIndice), 2.3% con 11 bits). Dos bocetos se
+// fusionan tomando el maximo de cada registro, asi que pueden combinarse periodos o
+// fragmentos distintos sin contar dos veces a nadie
+class HyperLogLog {
+public:
+    static constexpr int bitsIndice = 11;
+    static constexpr size_t numRegistros = size_t{1} << bitsIndice;
+
+private:
+    array<uint8_t, numRegistros> registros{}; // mayor rango visto en cada registro
+
+    // mezcla el hash de la biblioteca para que todos sus bits sean uniformes
+    static uint64_t mezclar(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+public:
+    void registrar(string_view clave) {
+        uint64_t hash = mezclar(std::hash<string_view>{}(clave));
+        size_t indice = hash >> (64 - bitsIndice); // los primeros bits eligen el registro
+        uint64_t resto = hash << bitsIndice; // el resto da el rango
+        uint8_t rango = static_cast<uint8_t>(resto ? countl_zero(resto) + 1 : 64 - bitsIndice + 1);
+        if (rango > registros[indice]) registros[indice] = rango;
+    }
+
+    void fusionar(const HyperLogLog& otro) {
+        for (size_t i = 0; i < numRegistros; ++i) registros[i] = max(registros[i], otro.registros[i]);
+    }
+
+    // numero estimado de claves distintas
+    double estimar() const {
+        constexpr double m = numRegistros;
+        constexpr double alfa = 0.7213 / (1.0 + 1.079 / m);
+        double suma = 0.0;
+        size_t vacios = 0;
+        for (uint8_t r : registros) {
+            suma += ldexp(1.0, -r);
+            vacios += r == 0;
+        }
+        double estimacion = alfa * m * m / suma;
+        if (estimacion <= 2.5 * m && vacios) estimacion = m * log(m / vacios); // pocas claves: conteo lineal
+        return estimacion;
+    }
+
+    // error relativo tipico de la estimacion
+    static double errorRelativo() {
+        return 1.04 / sqrt(static_cast<double>(numRegistros));
+    }
+};
+
+// usuarios distintos por hora y por dia. Las horas se guardan durante horasRetenidas y los
+// dias durante diasRetenidos; los dias anteriores se pliegan en un unico boceto historico,
+// asi que la memoria esta acotada. Una consulta fusiona los dias completos de la ventana y
+// las horas de los extremos, asi que usa memoria constante y unos pocos cientos de bocetos
+// como mucho
+class DistintosPorPeriodo {
+public:
+    static constexpr time_t segundosHora = 3600;
+    static constexpr time_t segundosDia = 86400;
+    static constexpr int64_t horasRetenidas = 7 * 24;
+    static constexpr int64_t diasRetenidos = 366; // ventana mas larga que se distingue por dias
+
+private:
+    map<int64_t, HyperLogLog> horas; // boceto de cada hora (hora / segundosHora)
+    map<int64_t, HyperLogLog> dias; // boceto de cada dia (hora / segundosDia)
+    HyperLogLog historico; // usuarios de todos los dias anteriores a primerDiaRetenido
+    int64_t horaMasReciente = INT64_MIN; // hora mas reciente registrada
+    int64_t primerDiaRetenido = INT64_MIN; // los dias anteriores estan plegados en historico
+
+    // division que redondea hacia abajo tambien para horas negativas
+    static int64_t periodo(time_t hora, time_t duracion) {
+        return hora >= 0 ? hora / duracion : -((-hora + duracion - 1) / duracion);
+    }
+
+    // boceto en el que se registra un dia: el suyo o el historico si ya se plego
+    HyperLogLog& bocetoDia(int64_t d) {
+        return d < primerDiaRetenido ? historico : dias[d];
+    }
+
+    // descarta las horas antiguas y pliega en historico los dias fuera de la retencion
+    void compactar() {
+        horas.erase(horas.begin(), horas.lower_bound(horaMasReciente - horasRetenidas + 1));
+        int64_t limite = periodo(horaMasReciente, segundosDia / segundosHora) - diasRetenidos + 1;
+        if (limite <= primerDiaRetenido) return;
+        auto fin = dias.lower_bound(limite);
+        for (auto dia = dias.begin(); dia != fin; ++dia) historico.fusionar(dia->second);
+        dias.erase(dias.begin(), fin);
+        primerDiaRetenido = limite;
+    }
+
+public:
+    void registrar(string_view usuario, time_t hora) {
+        int64_t h = periodo(hora, segundosHora);
+        bocetoDia(periodo(hora, segundosDia)).registrar(usuario);
+        if (h + horasRetenidas <= horaMasReciente) return; // hora ya compactada en su dia
+        horas[h].registrar(usuario);
+        if (h > horaMasReciente) {
+            horaMasReciente = h;
+            compactar();
+        }
+    }
+
+    // añade los usuarios de otro fragmento
+    void fusionar(const DistintosPorPeriodo& otro) {
+        historico.fusionar(otro.historico);
+        for (const auto& [d, boceto] : otro.dias) bocetoDia(d).fusionar(boceto);
+        for (const auto& [h, boceto] : otro.horas) {
+            if (h + horasRetenidas > horaMasReciente) horas[h].fusionar(boceto);
+        }
+        if (otro.horaMasReciente > horaMasReciente) {
+            horaMasReciente = otro.horaMasReciente;
+            compactar();
+        }
+    }
+
+    // boceto de los usuarios con accesos en [desde, hasta). Los extremos se ajustan a la
+    // hora; si una hora ya se compacto se usa su dia entero, por lo que la ventana puede
+    // ampliarse hasta el dia completo en los extremos antiguos, y si alcanza los dias
+    // plegados se usa el historico entero. La ventana se recorta a los dias guardados, asi
+    // que una ventana muy amplia no recorre mas de diasRetenidos dias
+    HyperLogLog bocetoVentana(time_t desde, time_t hasta) const {
+        HyperLogLog resultado;
+        constexpr int64_t horasDia = segundosDia / segundosHora;
+        int64_t h = periodo(desde, segundosHora), hFin = periodo(hasta - 1, segundosHora) + 1;
+        hFin = min(hFin, horaMasReciente + 1); // no hay accesos despues de la hora mas reciente
+        if (h >= hFin) return resultado;
+        if (periodo(h, horasDia) < primerDiaRetenido) { // la ventana alcanza los dias plegados
+            resultado.fusionar(historico);
+            h = primerDiaRetenido * horasDia;
+        }
+        if (!dias.empty()) h = max(h, dias.begin()->first * horasDia); // no hay accesos antes del primer dia guardado
+        while (h < hFin) {
+            if (h % horasDia == 0 && h + horasDia <= hFin) { // dia completo
+                auto dia = dias.find(h / horasDia);
+                if (dia != dias.end()) resultado.fusionar(dia->second);
+                h += horasDia;
+            } else if (auto hora = horas.find(h); hora != horas.end() || h + horasRetenidas > horaMasReciente) {
+                if (hora != horas.end()) resultado.fusionar(hora->second);
+                ++h;
+            } else { // hora compactada: se toma el dia al que pertenece
+                int64_t d = periodo(h * segundosHora, segundosDia);
+                auto dia = dias.find(d);
+                if (dia != dias.end()) resultado.fusionar(dia->second);
+                h = (d + 1) * horasDia;
+            }
+        }
+        return resultado;
+    }
+
+    // usuarios distintos estimados en [desde, hasta)
+    double estimar(time_t desde, time_t hasta) const {
+        return bocetoVentana(desde, hasta).estimar();
+    }
+
+    // usuarios distintos estimados en todo el historial
+    double estimarTotal() const {
+        HyperLogLog resultado = historico;
+        for (const auto& [d, boceto] : dias) resultado.fusionar(boceto);
+        return resultado.estimar();
+    }
+};
+
+#endif // BOCETOS_H
@@ -0,0 +1,60 @@
+#ifndef CATALOGO_H
+#define CATALOGO_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "internado.h"
+using namespace std;
+
+// -----CATALOGO DE ACTIVIDADES-----
+// catalogo que interna las descripciones de actividades en ids compactos; las colas y
+// los informes trabajan con ids y la descripcion solo se recupera al mostrarla
+class CatalogoActividades {
+public:
+    // actividades que se asignan automaticamente al iniciar sesion; ocupan los ids 0..3
+    static constexpr array<const char*, 4> predefinidas = {
+        "Actualizar datos personales.", // actividad 1
+        "Configurar autenticacion en dos pasos.", // actividad 2
+        "Revisar historial de accesos.", // actividad 3
+        "Aceptar terminos y condiciones." // actividad 4
+    };
+
+private:
+    TablaInternado descripciones; // descripcion de cada id
+
+public:
+    CatalogoActividades() {
+        for (const char* descripcion : predefinidas) descripciones.internar(descripcion);
+    }
+
+    // id de una actividad predefinida
+    static constexpr uint32_t idPredefinida(size_t indice) {
+        return static_cast<uint32_t>(indice);
+    }
+
+    // devuelve el id de una descripcion, registrandola si es nueva
+    uint32_t internar(string_view descripcion) {
+        return descripciones.internar(descripcion);
+    }
+
+    // devuelve el id de una descripcion o TablaInternado::sinId si no esta registrada
+    uint32_t buscar(string_view descripcion) const {
+        return descripciones.buscar(descripcion);
+    }
+
+    // devuelve la descripcion de un id
+    const string& descripcion(uint32_t id) const {
+        return descripciones.valor(id);
+    }
+
+    size_t size() const {
+        return descripciones.size();
+    }
+};
+
+// catalogo de actividades compartido por todas las colas
+inline CatalogoActividades catalogoActividades;
+
+#endif //CATALOGO_H
@@ -0,0 +1,249 @@
+#ifndef COLUMNAS_H
+#define COLUMNAS_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <ctime>
+#include <span>
+#include <utility>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define COLUMNAS_SIMD_X86 1
+#include <immintrin.h>
+#endif
+using namespace std;
+
+// -----OPERACIONES SOBRE COLUMNAS DE HORAS-----
+// recorren una columna contigua de time_t comparando varias horas por instruccion. Cada
+// operacion tiene una version escalar, otra SSE4.2 (2 horas por comparacion) y otra AVX2
+// (4 horas); la version sin sufijo elige la mejor que admite el procesador al ejecutarse.
+// Los rangos son siempre [desde, hasta)
+static_assert(sizeof(time_t) == 8, "las operaciones sobre columnas esperan time_t de 64 bits");
+
+// juego de instrucciones usado por las operaciones sin sufijo
+enum class NivelSimd : unsigned char { Escalar, Sse42, Avx2 };
+
+inline NivelSimd detectarNivelSimd() {
+#ifdef COLUMNAS_SIMD_X86
+    static const NivelSimd nivel = __builtin_cpu_supports("avx2")     ? NivelSimd::Avx2
+                                   : __builtin_cpu_supports("sse4.2") ? NivelSimd::Sse42
+                                                                      : NivelSimd::Escalar;
+    return nivel;
+#else
+    return NivelSimd::Escalar;
+#endif
+}
+
+// --- versiones escalares ---
+inline size_t contarEnRangoEscalar(span<const time_t> horas, time_t desde, time_t hasta) {
+    size_t total = 0;
+    for (time_t h : horas) total += (h >= desde) & (h < hasta); // sin saltos
+    return total;
+}
+
+// escribe en seleccion las posiciones de las horas del rango; seleccion debe tener sitio
+// para horas.size() posiciones. Devuelve cuantas escribio
+inline size_t filtrarEnRangoEscalar(span<const time_t> horas, time_t desde, time_t hasta, uint32_t* seleccion) {
+    size_t n = 0;
+    for (size_t i = 0; i < horas.size(); ++i) {
+        seleccion[n] = static_cast<uint32_t>(i);
+        n += (horas[i] >= desde) & (horas[i] < hasta); // escribe siempre y avanza solo si cumple
+    }
+    return n;
+}
+
+// posicion de la primera hora del rango, o horas.size() si no hay ninguna
+inline size_t primeroEnRangoEscalar(span<const time_t> horas, time_t desde, time_t hasta) {
+    for (size_t i = 0; i < horas.size(); ++i) {
+        if (horas[i] >= desde && horas[i] < hasta) return i;
+    }
+    return horas.size();
+}
+
+// menor y mayor hora de una columna no vacia
+inline pair<time_t, time_t> minimoMaximoEscalar(span<const time_t> horas) {
+    time_t minimo = horas[0], maximo = horas[0];
+    for (time_t h : horas) {
+        minimo = min(minimo, h);
+        maximo = max(maximo, h);
+    }
+    return {minimo, maximo};
+}
+
+#ifdef COLUMNAS_SIMD_X86
+// --- versiones SSE4.2 ---
+// mascara de 2 bits con las horas de v que estan en [desde, hasta)
+__attribute__((target("sse4.2"))) inline unsigned mascaraRangoSse(__m128i v, __m128i desde, __m128i hasta) {
+    __m128i antes = _mm_cmpgt_epi64(desde, v); // v < desde
+    __m128i dentro = _mm_andnot_si128(antes, _mm_cmpgt_epi64(hasta, v)); // y v < hasta
+    return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(dentro)));
+}
+
+__attribute__((target("sse4.2"))) inline size_t contarEnRangoSse42(span<const time_t> horas, time_t desde, time_t hasta) {
+    __m128i vDesde = _mm_set1_epi64x(desde), vHasta = _mm_set1_epi64x(hasta);
+    size_t total = 0, i = 0;
+    for (; i + 2 <= horas.size(); i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(horas.data() + i));
+        total += popcount(mascaraRangoSse(v, vDesde, vHasta));
+    }
+    return total + contarEnRangoEscalar(horas.subspan(i), desde, hasta);
+}
+
+__attribute__((target("sse4.2"))) inline size_t filtrarEnRangoSse42(span<const time_t> horas, time_t desde, time_t hasta, uint32_t* seleccion) {
+    __m128i vDesde = _mm_set1_epi64x(desde), vHasta = _mm_set1_epi64x(hasta);
+    size_t n = 0, i = 0;
+    for (; i + 2 <= horas.size(); i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(horas.data() + i));
+        for (unsigned m = mascaraRangoSse(v, vDesde, vHasta); m; m &= m - 1) {
+            seleccion[n++] = static_cast<uint32_t>(i + countr_zero(m));
+        }
+    }
+    size_t resto = filtrarEnRangoEscalar(horas.subspan(i), desde, hasta, seleccion + n);
+    for (size_t k = n; k < n + resto; ++k) seleccion[k] += static_cast<uint32_t>(i); // posiciones relativas a la cola
+    return n + resto;
+}
+
+__attribute__((target("sse4.2"))) inline size_t primeroEnRangoSse42(span<const time_t> horas, time_t desde, time_t hasta) {
+    __m128i vDesde = _mm_set1_epi64x(desde), vHasta = _mm_set1_epi64x(hasta);
+    size_t i = 0;
+    for (; i + 2 <= horas.size(); i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(horas.data() + i));
+        if (unsigned m = mascaraRangoSse(v, vDesde, vHasta)) return i + countr_zero(m);
+    }
+    return i + primeroEnRangoEscalar(horas.subspan(i), desde, hasta);
+}
+
+__attribute__((target("sse4.2"))) inline pair<time_t, time_t> minimoMaximoSse42(span<const time_t> horas) {
+    if (horas.size() < 2) return minimoMaximoEscalar(horas);
+    __m128i vMin = _mm_loadu_si128(reinterpret_cast<const __m128i*>(horas.data())), vMax = vMin;
+    size_t i = 2;
+    for (; i + 2 <= horas.size(); i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(horas.data() + i));
+        vMin = _mm_blendv_epi8(vMin, v, _mm_cmpgt_epi64(vMin, v));
+        vMax = _mm_blendv_epi8(vMax, v, _mm_cmpgt_epi64(v, vMax));
+    }
+    alignas(16) time_t minimos[2], maximos[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(minimos), vMin);
+    _mm_store_si128(reinterpret_cast<__m128i*>(maximos), vMax);
+    time_t minimo = min(minimos[0], minimos[1]), maximo = max(maximos[0], maximos[1]);
+    for (; i < horas.size(); ++i) {
+        minimo = min(minimo, horas[i]);
+        maximo = max(maximo, horas[i]);
+    }
+    return {minimo, maximo};
+}
+
+// --- versiones AVX2 ---
+// mascara de 4 bits con las horas de v que estan en [desde, hasta)
+__attribute__((target("avx2"))) inline unsigned mascaraRangoAvx2(__m256i v, __m256i desde, __m256i hasta) {
+    __m256i antes = _mm256_cmpgt_epi64(desde, v); // v < desde
+    __m256i dentro = _mm256_andnot_si256(antes, _mm256_cmpgt_epi64(hasta, v)); // y v < hasta
+    return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(dentro)));
+}
+
+__attribute__((target("avx2"))) inline size_t contarEnRangoAvx2(span<const time_t> horas, time_t desde, time_t hasta) {
+    __m256i vDesde = _mm256_set1_epi64x(desde), vHasta = _mm256_set1_epi64x(hasta);
+    __m256i acumulado = _mm256_setzero_si256(); // cada carril resta 1 (todo unos) por acierto
+    size_t i = 0;
+    for (; i + 4 <= horas.size(); i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(horas.data() + i));
+        __m256i dentro = _mm256_andnot_si256(_mm256_cmpgt_epi64(vDesde, v), _mm256_cmpgt_epi64(vHasta, v));
+        acumulado = _mm256_sub_epi64(acumulado, dentro);
+    }
+    alignas(32) uint64_t carriles[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(carriles), acumulado);
+    size_t total = carriles[0] + carriles[1] + carriles[2] + carriles[3];
+    return total + contarEnRangoEscalar(horas.subspan(i), desde, hasta);
+}
+
+__attribute__((target("avx2"))) inline size_t filtrarEnRangoAvx2(span<const time_t> horas, time_t desde, time_t hasta, uint32_t* seleccion) {
+    __m256i vDesde = _mm256_set1_epi64x(desde), vHasta = _mm256_set1_epi64x(hasta);
+    size_t n = 0, i = 0;
+    for (; i + 4 <= horas.size(); i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(horas.data() + i));
+        for (unsigned m = mascaraRangoAvx2(v, vDesde, vHasta); m; m &= m - 1) {
+            seleccion[n++] = static_cast<uint32_t>(i + countr_zero(m));
+        }
+    }
+    size_t resto = filtrarEnRangoEscalar(horas.subspan(i), desde, hasta, seleccion + n);
+    for (size_t k = n; k < n + resto; ++k) seleccion[k] += static_cast<uint32_t>(i); // posiciones relativas a la cola
+    return n + resto;
+}
+
+__attribute__((target("avx2"))) inline size_t primeroEnRangoAvx2(span<const time_t> horas, time_t desde, time_t hasta) {
+    __m256i vDesde = _mm256_set1_epi64x(desde), vHasta = _mm256_set1_epi64x(hasta);
+    size_t i = 0;
+    for (; i + 4 <= horas.size(); i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(horas.data() + i));
+        if (unsigned m = mascaraRangoAvx2(v, vDesde, vHasta)) return i + countr_zero(m);
+    }
+    return i + primeroEnRangoEscalar(horas.subspan(i), desde, hasta);
+}
+
+__attribute__((target("avx2"))) inline pair<time_t, time_t> minimoMaximoAvx2(span<const time_t> horas) {
+    if (horas.size() < 4) return minimoMaximoEscalar(horas);
+    __m256i vMin = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(horas.data())), vMax = vMin;
+    size_t i = 4;
+    for (; i + 4 <= horas.size(); i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(horas.data() + i));
+        vMin = _mm256_blendv_epi8(vMin, v, _mm256_cmpgt_epi64(vMin, v));
+        vMax = _mm256_blendv_epi8(vMax, v, _mm256_cmpgt_epi64(v, vMax));
+    }
+    alignas(32) time_t minimos[4], maximos[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(minimos), vMin);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(maximos), vMax);
+    time_t minimo = *min_element(minimos, minimos + 4), maximo = *max_element(maximos, maximos + 4);
+    for (; i < horas.size(); ++i) {
+        minimo = min(minimo, horas[i]);
+        maximo = max(maximo, horas[i]);
+    }
+    return {minimo, maximo};
+}
+#endif // COLUMNAS_SIMD_X86
+
+// --- versiones que eligen el juego de instrucciones ---
+inline size_t contarEnRango(span<const time_t> horas, time_t desde, time_t hasta) {
+#ifdef COLUMNAS_SIMD_X86
+    switch (detectarNivelSimd()) {
+        case NivelSimd::Avx2: return contarEnRangoAvx2(horas, desde, hasta);
+        case NivelSimd::Sse42: return contarEnRangoSse42(horas, desde, hasta);
+        case NivelSimd::Escalar: break;
+    }
+#endif
+    return contarEnRangoEscalar(horas, desde, hasta);
+}
+
+inline size_t filtrarEnRango(span<const time_t> horas, time_t desde, time_t hasta, uint32_t* seleccion) {
+#ifdef COLUMNAS_SIMD_X86
+    switch (detectarNivelSimd()) {
+        case NivelSimd::Avx2: return filtrarEnRangoAvx2(horas, desde, hasta, seleccion);
+        case NivelSimd::Sse42: return filtrarEnRangoSse42(horas, desde, hasta, seleccion);
+        case NivelSimd::Escalar: break;
+    }
+#endif
+    return filtrarEnRangoEscalar(horas, desde, hasta, seleccion);
+}
+
+inline size_t primeroEnRango(span<const time_t> horas, time_t desde, time_t hasta) {
+#ifdef COLUMNAS_SIMD_X86
+    switch (detectarNivelSimd()) {
+        case NivelSimd::Avx2: return primeroEnRangoAvx2(horas, desde, hasta);
+        case NivelSimd::Sse42: return primeroEnRangoSse42(horas, desde, hasta);
+        case NivelSimd::Escalar: break;
+    }
+#endif
+    return primeroEnRangoEscalar(horas, desde, hasta);
+}
+
+inline pair<time_t, time_t> minimoMaximo(span<const time_t> horas) {
+#ifdef COLUMNAS_SIMD_X86
+    switch (detectarNivelSimd()) {
+        case NivelSimd::Avx2: return minimoMaximoAvx2(horas);
+        case NivelSimd::Sse42: return minimoMaximoSse42(horas);
+        case NivelSimd::Escalar: break;
+    }
+#endif
+    return minimoMaximoEscalar(horas);
+}
+
+#endif // COLUMNAS_H
@@ -0,0 +1,291 @@
+#ifndef CONSULTAS_H
+#define CONSULTAS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+#include "accesos.h"
+#include "actividades.h"
+#include "tabla_hash.h"
+using namespace std;
+
+// -----CONSULTAS DEL ANALISTA-----
+// datos sobre los que se consulta
+enum class FuenteConsulta : unsigned char { Accesos, Actividades };
+
+// que devuelve una consulta
+enum class AgregacionConsulta : unsigned char {
+    Listar, // las filas que cumplen los filtros, hasta el limite
+    Contar, // solo cuantas filas los cumplen
+    PorUsuario, // filas por usuario
+    PorPerfil, // filas por perfil (accesos)
+    PorActividad // filas por actividad (actividades)
+};
+
+// consulta ad hoc; los filtros vacios o a 0 no restringen. El usuario de los accesos se
+// compara tal como se registro; el de las actividades sin distinguir mayusculas, como en la cola
+struct Consulta {
+    FuenteConsulta fuente = FuenteConsulta::Accesos;
+    string usuario; // usuario exacto
+    int perfil = 0; // perfil del acceso (solo accesos)
+    string actividad; // descripcion exacta (solo actividades)
+    time_t desde = 0; // hora minima incluida
+    time_t hasta = 0; // hora maxima excluida
+    AgregacionConsulta agregacion = AgregacionConsulta::Listar;
+    size_t limite = 20; // filas maximas al listar
+};
+
+// estructura con la que se resuelve una consulta
+enum class IndiceConsulta : unsigned char {
+    TablaNombres, // accesos por usuario que mantiene la lista (modo exacto)
+    Acumulados, // accesos por perfil y periodo
+    ColumnaHoras, // horas de los accesos, contiguas
+    CadenaUsuario, // actividades pendientes de cada usuario
+    ParesPendientes, // veces que cada par (usuario, actividad) esta pendiente
+    Recorrido // sin indice: se leen todos los registros
+};
+
+inline constexpr const char* nombresIndiceConsulta[] = {"tabla de nombres", "acumulados por perfil", "columna de horas",
+                                                        "cadena del usuario", "pares pendientes", "recorrido completo"};
+
+// plan de una consulta: el indice elegido y los filtros que quedan por comprobar en cada fila
+struct PlanConsulta {
+    IndiceConsulta indice = IndiceConsulta::Recorrido;
+    bool soloIndice = false; // el indice da la respuesta sin leer filas
+    bool podaPorNombre = false; // la tabla de nombres descarta antes a los usuarios sin accesos
+    vector<string> residuales; // filtros comprobados fila a fila
+
+    string describir() const {
+        string texto = nombresIndiceConsulta[static_cast<int>(indice)];
+        if (soloIndice) texto += ", sin leer filas";
+        if (podaPorNombre) texto += "; tabla de nombres para descartar usuarios sin accesos";
+        for (size_t i = 0; i < residuales.size(); ++i) texto += (i ? ", " : "; filtros por fila: ") + residuales[i];
+        return texto;
+    }
+};
+
+// resultado de una consulta
+struct ResultadoConsulta {
+    PlanConsulta plan; // como se resolvio
+    uint64_t total = 0; // filas que cumplen los filtros
+    uint64_t examinadas = 0; // filas leidas para comprobar los filtros
+    vector<string> filas; // filas listadas, hasta el limite
+    vector<pair<string, uint64_t>> grupos; // filas por grupo, ordenadas por nombre del grupo
+};
+
+// acumula las filas que cumplen los filtros segun la agregacion de la consulta
+class AgregadorConsulta {
+private:
+    const Consulta& consulta;
+    ResultadoConsulta& resultado;
+    TablaHashPlana<string, uint64_t> grupos; // filas por grupo
+
+public:
+    AgregadorConsulta(const Consulta& consulta, ResultadoConsulta& resultado) : consulta(consulta), resultado(resultado) {}
+
+    // anota una fila; fila() y grupo() solo se llaman si la agregacion los necesita
+    template <typename Fila, typename Grupo>
+    void anotar(Fila fila, Grupo grupo) {
+        ++resultado.total;
+        if (consulta.agregacion == AgregacionConsulta::Listar) {
+            if (resultado.filas.size() < consulta.limite) resultado.filas.push_back(fila());
+        } else if (consulta.agregacion != AgregacionConsulta::Contar) {
+            grupos[grupo()]++;
+        }
+    }
+
+    // anota n filas de un grupo que el indice ya conto
+    void anotarGrupo(const string& grupo, uint64_t n) {
+        resultado.total += n;
+        if (n && consulta.agregacion != AgregacionConsulta::Contar) grupos[grupo] += n;
+    }
+
+    // pasa los grupos al resultado, ordenados por nombre
+    void cerrar() {
+        grupos.recorrer([&](const string& grupo, uint64_t n) { resultado.grupos.emplace_back(grupo, n); });
+        sort(resultado.grupos.begin(), resultado.grupos.end());
+    }
+};
+
+// hora con fecha para las filas de una consulta
+inline string formatearHoraConsulta(time_t hora) {
+    char fecha[32];
+    strftime(fecha, sizeof(fecha), "%Y-%m-%d %H:%M:%S", localtime(&hora));
+    return fecha;
+}
+
+inline string nombrePerfilConsulta(int perfil) {
+    const DescriptorPerfil* descriptor = buscarPerfil(perfil);
+    return descriptor ? descriptor->nombre : "desconocido";
+}
+
+// elige como resolver una consulta de accesos: la tabla de nombres para contar los de un
+// usuario, los acumulados para contar por perfil en dias completos, la columna de horas
+// para un rango de tiempo y un recorrido de la lista solo si no sirve ningun indice
+inline PlanConsulta planificarConsulta(const Consulta& consulta, const ListaEnlazadaAccesos& accesos) {
+    PlanConsulta plan;
+    bool hayUsuario = !consulta.usuario.empty(), hayPerfil = consulta.perfil != 0;
+    bool hayTiempo = consulta.desde || consulta.hasta;
+    bool tablaNombres = accesos.getAproximadas() == nullptr; // el modo aproximado no guarda un contador por usuario
+    bool cuenta = consulta.agregacion == AgregacionConsulta::Contar;
+    // los acumulados ajustan los extremos al periodo retenido: solo son exactos con dias completos
+    bool diasCompletos = consulta.desde % 86400 == 0 && consulta.hasta % 86400 == 0;
+
+    if (hayUsuario && tablaNombres && !hayPerfil && !hayTiempo && (cuenta || consulta.agregacion == AgregacionConsulta::PorUsuario)) {
+        plan.indice = IndiceConsulta::TablaNombres;
+        plan.soloIndice = true;
+        return plan;
+    }
+    if (!hayUsuario && diasCompletos && (!hayPerfil || buscarPerfil(consulta.perfil))
+        && (cuenta || consulta.agregacion == AgregacionConsulta::PorPerfil)) {
+        plan.indice = IndiceConsulta::Acumulados;
+        plan.soloIndice = true;
+        return plan;
+    }
+
+    plan.indice = hayTiempo ? IndiceConsulta::ColumnaHoras : IndiceConsulta::Recorrido;
+    plan.soloIndice = hayTiempo && cuenta && !hayUsuario && !hayPerfil;
+    plan.podaPorNombre = hayUsuario && tablaNombres;
+    if (hayUsuario) plan.residuales.push_back("usuario");
+    if (hayPerfil) plan.residuales.push_back("perfil");
+    return plan;
+}
+
+// elige como resolver una consulta de actividades: los pares pendientes o la cadena del
+// usuario cuando se filtra por usuario, y un recorrido de la cola en otro caso
+inline PlanConsulta planificarConsulta(const Consulta& consulta) {
+    PlanConsulta plan;
+    bool hayUsuario = !consulta.usuario.empty(), hayActividad = !consulta.actividad.empty();
+    bool hayTiempo = consulta.desde || consulta.hasta;
+    bool cuenta = consulta.agregacion == AgregacionConsulta::Contar;
+
+    if (hayUsuario) {
+        plan.indice = hayActividad ? IndiceConsulta::ParesPendientes : IndiceConsulta::CadenaUsuario;
+        plan.soloIndice = !hayTiempo && (cuenta || (!hayActividad && consulta.agregacion == AgregacionConsulta::PorUsuario));
+        if (plan.soloIndice) return plan;
+        plan.indice = IndiceConsulta::CadenaUsuario; // hay que leer las actividades del usuario
+    } else {
+        plan.indice = IndiceConsulta::Recorrido;
+    }
+    if (hayActividad) plan.residuales.push_back("actividad");
+    if (hayTiempo) plan.residuales.push_back("hora");
+    return plan;
+}
+
+// ejecuta una consulta de accesos segun su plan
+inline ResultadoConsulta consultarAccesos(const Consulta& consulta, const ListaEnlazadaAccesos& accesos) {
+    ResultadoConsulta resultado;
+    resultado.plan = planificarConsulta(consulta, accesos);
+    const PlanConsulta& plan = resultado.plan;
+    AgregadorConsulta agregador(consulta, resultado);
+    time_t hasta = consulta.hasta ? consulta.hasta : numeric_limits<time_t>::max();
+
+    if (plan.indice == IndiceConsulta::TablaNombres) {
+        const int* n = accesos.getConteos().buscar(consulta.usuario);
+        agregador.anotarGrupo(consulta.usuario, n ? *n : 0);
+    } else if (plan.indice == IndiceConsulta::Acumulados) {
+        auto [primera, ultima] = accesos.rangoHoras();
+        time_t desde = consulta.desde ? consulta.desde : primera;
+        time_t fin = consulta.hasta ? consulta.hasta : ultima + 1;
+        if (accesos.getTotalAccesos() && desde < fin) {
+            const AcumuladosAccesos& acumulados = accesos.getAcumulados();
+            if (consulta.agregacion == AgregacionConsulta::Contar) {
+                agregador.anotarGrupo("", acumulados.contar(desde, fin, consulta.perfil));
+            } else {
+                uint64_t todos = acumulados.contar(desde, fin), registrados = 0;
+                for (int perfil = 1; perfil < static_cast<int>(AcumuladosAccesos::numPerfiles); ++perfil) {
+                    uint64_t n = acumulados.contar(desde, fin, perfil);
+                    registrados += n;
+                    if (!consulta.perfil || consulta.perfil == perfil) agregador.anotarGrupo(nombrePerfilConsulta(perfil), n);
+                }
+                if (!consulta.perfil) agregador.anotarGrupo(nombrePerfilConsulta(0), todos - registrados);
+            }
+        }
+    } else if (plan.soloIndice) { // solo un rango de tiempo: se cuenta sobre la columna
+        agregador.anotarGrupo("", accesos.contarEnVentana(consulta.desde, hasta));
+    } else if (!plan.podaPorNombre || accesos.getConteos().contiene(consulta.usuario)) {
+        auto cumple = [&](const NodoAcceso* nodo) {
+            ++resultado.examinadas;
+            return (consulta.usuario.empty() || consulta.usuario == nodo->nombreUsuario)
+                   && (!consulta.perfil || consulta.perfil == nodo->perfil)
+                   && nodo->horaAcceso >= consulta.desde && nodo->horaAcceso < hasta;
+        };
+        auto anotar = [&](const NodoAcceso* nodo) {
+            agregador.anotar(
+                [&] { return string(nodo->nombreUsuario) + ", " + formatearHoraConsulta(nodo->horaAcceso) + ", " + nombrePerfilConsulta(nodo->perfil); },
+                [&] { return consulta.agregacion == AgregacionConsulta::PorUsuario ? string(nodo->nombreUsuario) : nombrePerfilConsulta(nodo->perfil); });
+        };
+        if (plan.indice == IndiceConsulta::ColumnaHoras) {
+            // la columna sigue el orden de insercion; se lista en orden cronologico como la lista
+            if (consulta.agregacion == AgregacionConsulta::Listar) {
+                vector<NodoAcceso*> nodos = accesos.filtrarPorHora(consulta.desde, hasta);
+                stable_sort(nodos.begin(), nodos.end(), [](const NodoAcceso* a, const NodoAcceso* b) { return a->horaAcceso < b->horaAcceso; });
+                for (const NodoAcceso* nodo : nodos) {
+                    if (cumple(nodo)) anotar(nodo);
+                }
+            } else {
+                accesos.recorrerPorHora(consulta.desde, hasta, [&](const NodoAcceso* nodo) {
+                    if (cumple(nodo)) anotar(nodo);
+                });
+            }
+        } else {
+            for (const NodoAcceso* nodo = accesos.getCabeza(); nodo; nodo = nodo->siguiente) {
+                if (cumple(nodo)) anotar(nodo);
+            }
+        }
+    }
+    agregador.cerrar();
+    return resultado;
+}
+
+// ejecuta una consulta de actividades pendientes segun su plan
+inline ResultadoConsulta consultarActividades(const Consulta& consulta, const ColaActividades& cola) {
+    ResultadoConsulta resultado;
+    resultado.plan = planificarConsulta(consulta);
+    const PlanConsulta& plan = resultado.plan;
+    AgregadorConsulta agregador(consulta, resultado);
+    time_t hasta = consulta.hasta ? consulta.hasta : numeric_limits<time_t>::max();
+    string usuario = toLowerCase(consulta.usuario); // la cola guarda los usuarios normalizados
+
+    if (plan.soloIndice && plan.indice == IndiceConsulta::ParesPendientes) {
+        agregador.anotarGrupo(usuario, cola.vecesPendiente(usuario, consulta.actividad));
+    } else if (plan.soloIndice) {
+        agregador.anotarGrupo(usuario, cola.pendientes(usuario));
+    } else {
+        auto visitar = [&](const RegistroActividad& registro) {
+            ++resultado.examinadas;
+            if ((!consulta.actividad.empty() && consulta.actividad != registro.getActividad())
+                || registro.hora < consulta.desde || registro.hora >= hasta) return;
+            agregador.anotar(
+                [&] { return registro.getUsuario() + ", " + registro.getActividad() + ", " + formatearHoraConsulta(registro.hora) + (registro.vencida ? " [VENCIDA]" : ""); },
+                [&] { return consulta.agregacion == AgregacionConsulta::PorUsuario ? registro.getUsuario() : registro.getActividad(); });
+        };
+        if (plan.indice == IndiceConsulta::CadenaUsuario) cola.recorrerUsuario(usuario, visitar);
+        else cola.recorrer(visitar);
+    }
+    agregador.cerrar();
+    return resultado;
+}
+
+inline ResultadoConsulta ejecutarConsulta(const Consulta& consulta, const ListaEnlazadaAccesos& accesos, const ColaActividades& cola) {
+    return consulta.fuente == FuenteConsulta::Accesos ? consultarAccesos(consulta, accesos) : consultarActividades(consulta, cola);
+}
+
+// muestra el plan y el resultado de una consulta
+inline void mostrarResultadoConsulta(const Consulta& consulta, const ResultadoConsulta& resultado) {
+    cout << "Plan: " << resultado.plan.describir() << "\n";
+    if (consulta.agregacion == AgregacionConsulta::Listar) {
+        for (const string& fila : resultado.filas) cout << fila << "\n";
+        if (resultado.filas.size() < resultado.total) cout << "... " << resultado.total - resultado.filas.size() << " filas mas\n";
+    } else {
+        for (const auto& [grupo, n] : resultado.grupos) cout << grupo << ": " << n << "\n";
+    }
+    cout << "Total: " << resultado.total << " (filas leidas: " << resultado.examinadas << ")" << endl;
+}
+
+#endif // CONSULTAS_H
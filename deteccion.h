@@ -0,0 +1,159 @@
+#ifndef DETECCION_H
+#define DETECCION_H
+
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include "internado.h"
+#include "catalogo.h"
+#include "tabla_hash.h"
+using namespace std;
+
+// -----DETECCION DE ACTIVIDADES SOSPECHOSAS-----
+// aviso de que un usuario repitio una actividad mas veces de las permitidas en la ventana
+struct AlertaSospechosa {
+    uint32_t usuario; // id en tablaUsuarios
+    uint32_t actividad; // id en catalogoActividades
+    int repeticiones; // repeticiones dentro de la ventana al saltar la alerta
+    time_t hora; // hora de la repeticion que cruzo el umbral
+
+    const string& getUsuario() const {
+        return tablaUsuarios.valor(usuario);
+    }
+
+    const string& getActividad() const {
+        return catalogoActividades.descripcion(actividad);
+    }
+};
+
+// cuenta en una ventana deslizante las veces que se asigna cada par (usuario, actividad)
+// y avisa en cuanto un par supera el umbral. La ventana se divide en cubetas de tiempo;
+// cada evento se suma a su cubeta y al total del par, y al avanzar el tiempo las cubetas
+// que salen de la ventana restan sus conteos, asi que cada evento cuesta O(1) amortizado
+// y la memoria depende solo de los eventos dentro de la ventana
+class DetectorSospechosas {
+public:
+    static constexpr size_t numCubetas = 16; // resolucion de la ventana
+    static constexpr size_t maxAlertas = 100; // alertas recientes que se conservan
+
+private:
+    struct Cubeta {
+        int64_t indice = -1; // intervalo de tiempo que guarda la cubeta, o -1 si esta libre
+        TablaHashPlana<uint64_t, int> conteos; // eventos de cada par en la cubeta
+    };
+
+    struct EstadoPar {
+        int total = 0; // eventos del par dentro de la ventana
+        bool alertado = false; // ya se aviso mientras sigue por encima del umbral
+    };
+
+    time_t intervalo; // duracion de la ventana en segundos
+    int umbral; // repeticiones permitidas dentro de la ventana
+    time_t anchoCubeta; // segundos por cubeta
+    array<Cubeta, numCubetas> cubetas; // cubetas de la ventana, circulares por indice
+    TablaHashPlana<uint64_t, EstadoPar> ventana; // total de cada par con eventos en la ventana
+    int64_t cubetaActual = -1; // cubeta mas reciente vista
+    deque<AlertaSospechosa> alertas; // ultimas alertas, de la mas antigua a la mas reciente
+    function<void(const AlertaSospechosa&)> alAlertar; // aviso inmediato, opcional
+    mutable mutex cerrojo; // protege todo el estado
+
+    static uint64_t clavePar(uint32_t usuario, uint32_t actividad) {
+        return (static_cast<uint64_t>(usuario) << 32) | actividad;
+    }
+
+    // resta del total de la ventana los conteos de una cubeta y la deja libre
+    void vaciar(Cubeta& cubeta) {
+        cubeta.conteos.recorrer([&](uint64_t clave, int conteo) {
+            EstadoPar& estado = *ventana.buscar(clave);
+            estado.total -= conteo;
+            if (estado.total <= umbral) estado.alertado = false; // puede volver a avisar
+            if (estado.total == 0) ventana.borrar(clave);
+        });
+        cubeta.conteos.limpiar(); // conserva la capacidad para el siguiente intervalo
+        cubeta.indice = -1;
+    }
+
+    // avanza la ventana hasta la cubeta indicada, expulsando las que quedan fuera
+    void avanzar(int64_t indice) {
+        if (indice <= cubetaActual) return;
+        int64_t desde = max(cubetaActual + 1, indice - static_cast<int64_t>(numCubetas) + 1);
+        for (int64_t i = desde; i <= indice; ++i) {
+            Cubeta& cubeta = cubetas[i % numCubetas];
+            if (cubeta.indice != -1) vaciar(cubeta);
+            cubeta.indice = i;
+        }
+        cubetaActual = indice;
+    }
+
+public:
+    // intervalo en segundos; un par es sospechoso si se repite mas de umbral veces en el
+    DetectorSospechosas(time_t intervalo = 600, int umbral = 2)
+        : intervalo(intervalo), umbral(umbral),
+          anchoCubeta(max<time_t>(1, (intervalo + numCubetas - 1) / numCubetas)) {}
+
+    // indica la funcion a la que se avisa en cuanto un par cruza el umbral
+    void setAlAlertar(function<void(const AlertaSospechosa&)> aviso) {
+        lock_guard bloqueo(cerrojo);
+        alAlertar = std::move(aviso);
+    }
+
+    time_t getIntervalo() const {
+        return intervalo;
+    }
+
+    int getUmbral() const {
+        return umbral;
+    }
+
+    // anota una asignacion; las que llegan con una hora anterior a la ventana se ignoran
+    void registrar(uint32_t usuario, uint32_t actividad, time_t hora) {
+        lock_guard bloqueo(cerrojo);
+        int64_t indice = hora / anchoCubeta;
+        avanzar(indice);
+        if (indice <= cubetaActual - static_cast<int64_t>(numCubetas)) return; // fuera de la ventana
+
+        uint64_t clave = clavePar(usuario, actividad);
+        cubetas[indice % numCubetas].conteos[clave]++;
+        EstadoPar& estado = ventana[clave];
+        if (++estado.total > umbral && !estado.alertado) { // acaba de cruzar el umbral
+            estado.alertado = true;
+            if (alertas.size() == maxAlertas) alertas.pop_front();
+            alertas.push_back({usuario, actividad, estado.total, hora});
+            if (alAlertar) alAlertar(alertas.back());
+        }
+    }
+
+    // expulsa de la ventana lo anterior a ahora - intervalo
+    void actualizar(time_t ahora) {
+        lock_guard bloqueo(cerrojo);
+        avanzar(ahora / anchoCubeta);
+    }
+
+    // llama a visitar(usuario, actividad, repeticiones) para cada par que supera el umbral
+    // dentro de la ventana
+    template <typename Visitar>
+    void recorrerSospechosas(Visitar visitar) const {
+        lock_guard bloqueo(cerrojo);
+        ventana.recorrer([&](uint64_t clave, const EstadoPar& estado) {
+            if (estado.total > umbral) visitar(static_cast<uint32_t>(clave >> 32), static_cast<uint32_t>(clave), estado.total);
+        });
+    }
+
+    // copia de las ultimas alertas, de la mas antigua a la mas reciente
+    deque<AlertaSospechosa> getAlertas() const {
+        lock_guard bloqueo(cerrojo);
+        return alertas;
+    }
+
+    // pares con eventos dentro de la ventana
+    size_t paresEnVentana() const {
+        lock_guard bloqueo(cerrojo);
+        return ventana.size();
+    }
+};
+
+#endif // DETECCION_H
@@ -0,0 +1,377 @@
+#ifndef DIARIO_H
+#define DIARIO_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+using namespace std;
+
+// -----DIARIO DE ESCRITURA ANTICIPADA-----
+// configuracion del modo durable de una cola de actividades
+struct ConfiguracionDiario {
+    string ruta; // archivo del diario; el punto de control se guarda en ruta + ".ckp"
+    chrono::milliseconds intervaloCommit{5}; // espera maxima antes de sincronizar lo pendiente
+    size_t bytesPorGrupo = 1 << 20; // sincroniza antes si lo pendiente alcanza este tamaño
+    bool esperarConfirmacion = true; // cada operacion espera a que su registro sea durable
+    size_t bytesParaPuntoControl = 64 << 20; // tamaño del diario que dispara un punto de control
+};
+
+// diario de solo escritura al final con commit en grupo: los registros se acumulan en
+// memoria y un hilo los escribe y sincroniza con el disco (fsync) por grupos, de modo
+// que muchas operaciones comparten una sola sincronizacion. Cada registro lleva un numero
+// de secuencia (lsn) y una suma de control; la recuperacion parte del ultimo punto de
+// control y reaplica solo los registros posteriores
+class DiarioActividades {
+public:
+    enum TipoRegistro : uint8_t { Encolado = 1, Desencolado = 2 };
+
+private:
+    static constexpr char firmaPuntoControl[8] = {'T', 'G', 'P', 'E', 'L', 'C', 'K', 'P'};
+
+    ConfiguracionDiario configuracion;
+    FILE* archivo = nullptr; // diario abierto para añadir
+    vector<char> pendiente; // registros aun no escritos
+    vector<char> enVuelo; // grupo que el hilo esta escribiendo
+    uint64_t ultimoLsn = 0; // lsn del ultimo registro anotado
+    uint64_t lsnDurable = 0; // todos los registros hasta este lsn estan en disco
+    size_t bytesDiario = 0; // tamaño del diario desde el ultimo punto de control
+    int esperando = 0; // operaciones esperando confirmacion
+    bool escribiendo = false; // hay un grupo o un punto de control en curso
+    bool detener = false; // pide al hilo que termine
+    bool fallo = false; // un grupo no llego al disco; lo anotado despues no es durable hasta un punto de control
+    chrono::steady_clock::time_point ultimoIntento{}; // ultimo punto de control pedido tras un fallo
+    mutex cerrojo;
+    condition_variable hayTrabajo; // despierta al hilo de escritura
+    condition_variable hayDurable; // despierta a quienes esperan confirmacion
+    thread escritor;
+
+    // suma de control FNV-1a de 32 bits
+    static uint32_t sumaControl(const char* datos, size_t longitud, uint32_t semilla = 2166136261u) {
+        for (size_t i = 0; i < longitud; ++i) {
+            semilla = (semilla ^ static_cast<unsigned char>(datos[i])) * 16777619u;
+        }
+        return semilla;
+    }
+
+    template <typename T>
+    static void escribirValor(vector<char>& destino, T valor) {
+        const char* bytes = reinterpret_cast<const char*>(&valor);
+        destino.insert(destino.end(), bytes, bytes + sizeof(T));
+    }
+
+    static void escribirCadena(vector<char>& destino, string_view cadena) {
+        escribirValor(destino, static_cast<uint32_t>(cadena.size()));
+        destino.insert(destino.end(), cadena.begin(), cadena.end());
+    }
+
+    // lector secuencial sobre un bloque de bytes; marca error si se sale del bloque
+    struct Lector {
+        const char* datos;
+        size_t longitud;
+        size_t posicion = 0;
+        bool error = false;
+
+        template <typename T>
+        T valor() {
+            T resultado{};
+            if (posicion + sizeof(T) > longitud) {
+                error = true;
+                return resultado;
+            }
+            memcpy(&resultado, datos + posicion, sizeof(T));
+            posicion += sizeof(T);
+            return resultado;
+        }
+
+        string_view cadena() {
+            uint32_t tam = valor<uint32_t>();
+            if (error || posicion + tam > longitud) {
+                error = true;
+                return {};
+            }
+            string_view resultado(datos + posicion, tam);
+            posicion += tam;
+            return resultado;
+        }
+    };
+
+    // carga de un registro de encolado (tambien usada en el punto de control)
+    static void escribirEncolado(vector<char>& destino, string_view usuario, string_view actividad, time_t hora, time_t vencimiento) {
+        escribirValor(destino, static_cast<int64_t>(hora));
+        escribirValor(destino, static_cast<int64_t>(vencimiento));
+        escribirCadena(destino, usuario);
+        escribirCadena(destino, actividad);
+    }
+
+    template <typename AlEncolar>
+    static bool leerEncolado(Lector& lector, AlEncolar& alEncolar) {
+        time_t hora = static_cast<time_t>(lector.valor<int64_t>());
+        time_t vencimiento = static_cast<time_t>(lector.valor<int64_t>());
+        string_view usuario = lector.cadena();
+        string_view actividad = lector.cadena();
+        if (lector.error) return false;
+        alEncolar(usuario, actividad, hora, vencimiento);
+        return true;
+    }
+
+    // añade un registro al grupo pendiente; requiere el cerrojo del diario
+    uint64_t anotar(TipoRegistro tipo, const vector<char>& carga) {
+        uint64_t lsn = ++ultimoLsn;
+        uint32_t suma = sumaControl(carga.data(), carga.size(), sumaControl(reinterpret_cast<const char*>(&lsn), sizeof(lsn)));
+        escribirValor(pendiente, lsn);
+        escribirValor(pendiente, static_cast<uint8_t>(tipo));
+        escribirValor(pendiente, static_cast<uint32_t>(carga.size()));
+        escribirValor(pendiente, suma);
+        pendiente.insert(pendiente.end(), carga.begin(), carga.end());
+        if (pendiente.size() >= configuracion.bytesPorGrupo) hayTrabajo.notify_one();
+        return lsn;
+    }
+
+    // lleva al disco lo escrito en un archivo
+    static bool sincronizar(FILE* f) {
+        if (fflush(f) != 0) return false;
+#ifdef _WIN32
+        return _commit(_fileno(f)) == 0;
+#else
+        return fsync(fileno(f)) == 0;
+#endif
+    }
+
+    // bucle del hilo de escritura: agrupa lo pendiente y lo sincroniza de una vez
+    void bucleEscritor() {
+        unique_lock bloqueo(cerrojo);
+        while (true) {
+            hayTrabajo.wait_for(bloqueo, configuracion.intervaloCommit, [&] {
+                return detener || (!escribiendo && !pendiente.empty()
+                                   && (esperando > 0 || pendiente.size() >= configuracion.bytesPorGrupo));
+            });
+            if (escribiendo || pendiente.empty()) { // nada que escribir o punto de control en curso
+                if (detener && !escribiendo) break;
+                continue;
+            }
+            enVuelo.swap(pendiente);
+            uint64_t lsnGrupo = ultimoLsn;
+            escribiendo = true;
+            bloqueo.unlock();
+
+            // tras un fallo no se añade nada: el diario tendria un hueco de lsn y la recuperacion
+            // aplicaria los registros siguientes sobre un estado distinto. Se espera a que un
+            // punto de control lo vacie
+            bool correcto = !fallo && archivo && fwrite(enVuelo.data(), 1, enVuelo.size(), archivo) == enVuelo.size() && sincronizar(archivo);
+
+            bloqueo.lock();
+            if (!correcto && !fallo) cerr << "Error: No se pudo escribir el diario " << configuracion.ruta << "." << endl;
+            fallo |= !correcto;
+            bytesDiario += enVuelo.size();
+            enVuelo.clear();
+            escribiendo = false;
+            lsnDurable = lsnGrupo; // con error tambien avanza para no bloquear a quien espera; esperar ve el fallo
+            hayDurable.notify_all();
+        }
+    }
+
+public:
+    explicit DiarioActividades(ConfiguracionDiario configuracion) : configuracion(std::move(configuracion)) {}
+
+    ~DiarioActividades() {
+        {
+            lock_guard bloqueo(cerrojo);
+            detener = true;
+        }
+        hayTrabajo.notify_one();
+        if (escritor.joinable()) escritor.join();
+        if (archivo) {
+            if (!pendiente.empty() && !fallo) fwrite(pendiente.data(), 1, pendiente.size(), archivo); // ultimo grupo
+            sincronizar(archivo);
+            fclose(archivo);
+        }
+    }
+
+    DiarioActividades(const DiarioActividades&) = delete;
+    DiarioActividades& operator=(const DiarioActividades&) = delete;
+
+    const ConfiguracionDiario& getConfiguracion() const {
+        return configuracion;
+    }
+
+    // reconstruye el estado: aplica el punto de control y despues los registros del diario
+    // con lsn posterior, llamando a alEncolar(usuario, actividad, hora, vencimiento) y a
+    // alDesencolar(cantidad). Se detiene en el primer registro incompleto o corrupto y en el
+    // primer hueco de lsn, porque lo siguiente supone un estado que no se puede reconstruir.
+    // Despues abre el diario para añadir; devuelve false si no puede abrirlo
+    template <typename AlEncolar, typename AlDesencolar>
+    bool recuperar(AlEncolar alEncolar, AlDesencolar alDesencolar) {
+        uint64_t lsnBase = 0;
+        if (FILE* f = fopen((configuracion.ruta + ".ckp").c_str(), "rb")) {
+            vector<char> datos;
+            char bloque[1 << 16];
+            for (size_t leidos; (leidos = fread(bloque, 1, sizeof(bloque), f)) > 0;) datos.insert(datos.end(), bloque, bloque + leidos);
+            fclose(f);
+            // formato: firma, lsn, cantidad, registros y suma de control de todo lo anterior
+            if (datos.size() >= sizeof(firmaPuntoControl) + 20 && memcmp(datos.data(), firmaPuntoControl, sizeof(firmaPuntoControl)) == 0) {
+                Lector lector{datos.data(), datos.size() - sizeof(uint32_t)};
+                uint32_t suma;
+                memcpy(&suma, datos.data() + lector.longitud, sizeof(suma));
+                if (suma == sumaControl(datos.data(), lector.longitud)) {
+                    lector.posicion = sizeof(firmaPuntoControl);
+                    lsnBase = lector.valor<uint64_t>();
+                    uint64_t cantidad = lector.valor<uint64_t>();
+                    for (uint64_t i = 0; i < cantidad && leerEncolado(lector, alEncolar); ++i) {}
+                }
+            }
+        }
+        ultimoLsn = lsnBase;
+
+        if (FILE* f = fopen(configuracion.ruta.c_str(), "rb")) {
+            error_code error;
+            uint64_t restante = filesystem::file_size(configuracion.ruta, error); // bytes sin leer
+            if (error) restante = 0;
+            constexpr uint64_t bytesCabecera = sizeof(uint64_t) + sizeof(uint8_t) + 2 * sizeof(uint32_t);
+            vector<char> carga;
+            while (restante >= bytesCabecera) {
+                uint64_t lsn;
+                uint8_t tipo;
+                uint32_t longitud, suma;
+                if (fread(&lsn, sizeof(lsn), 1, f) != 1 || fread(&tipo, sizeof(tipo), 1, f) != 1
+                    || fread(&longitud, sizeof(longitud), 1, f) != 1 || fread(&suma, sizeof(suma), 1, f) != 1) break;
+                restante -= bytesCabecera;
+                if (longitud > restante) break; // cabecera rota: no reserva mas de lo que queda
+                restante -= longitud;
+                carga.resize(longitud);
+                if (longitud && fread(carga.data(), 1, longitud, f) != longitud) break;
+                if (suma != sumaControl(carga.data(), longitud, sumaControl(reinterpret_cast<const char*>(&lsn), sizeof(lsn)))) break;
+                if (lsn <= lsnBase) continue; // ya incluido en el punto de control
+                if (lsn != ultimoLsn + 1) break; // falta un registro
+                Lector lector{carga.data(), carga.size()};
+                if (tipo == Encolado) {
+                    if (!leerEncolado(lector, alEncolar)) break;
+                } else if (tipo == Desencolado) {
+                    uint64_t cantidad = lector.valor<uint64_t>();
+                    if (lector.error) break;
+                    alDesencolar(cantidad);
+                } else {
+                    break;
+                }
+                ultimoLsn = lsn;
+            }
+            fclose(f);
+        }
+        lsnDurable = ultimoLsn;
+
+        archivo = fopen(configuracion.ruta.c_str(), "ab");
+        if (!archivo) return false;
+        escritor = thread(&DiarioActividades::bucleEscritor, this);
+        return true;
+    }
+
+    // anota el encolado de una actividad y devuelve su lsn
+    uint64_t registrarEncolado(string_view usuario, string_view actividad, time_t hora, time_t vencimiento) {
+        vector<char> carga;
+        escribirEncolado(carga, usuario, actividad, hora, vencimiento);
+        lock_guard bloqueo(cerrojo);
+        return anotar(Encolado, carga);
+    }
+
+    // anota que se eliminaron cantidad actividades del frente y devuelve su lsn
+    uint64_t registrarDesencolado(uint64_t cantidad) {
+        vector<char> carga;
+        escribirValor(carga, cantidad);
+        lock_guard bloqueo(cerrojo);
+        return anotar(Desencolado, carga);
+    }
+
+    // espera a que el registro con ese lsn este en disco; sin modo de confirmacion no espera.
+    // Devuelve false si el diario fallo, porque entonces el registro no es recuperable
+    bool esperar(uint64_t lsn) {
+        unique_lock bloqueo(cerrojo);
+        if (!configuracion.esperarConfirmacion || lsnDurable >= lsn) return !fallo;
+        ++esperando;
+        hayTrabajo.notify_one();
+        hayDurable.wait(bloqueo, [&] { return lsnDurable >= lsn; });
+        --esperando;
+        return !fallo;
+    }
+
+    // indica si el diario crecio lo suficiente para hacer un punto de control, o si fallo
+    // una escritura y hace falta uno para volver a ser durable (como mucho uno por segundo)
+    bool necesitaPuntoControl() {
+        lock_guard bloqueo(cerrojo);
+        if (fallo) {
+            auto ahora = chrono::steady_clock::now();
+            if (ahora - ultimoIntento < chrono::seconds(1)) return false;
+            ultimoIntento = ahora;
+            return true;
+        }
+        return bytesDiario + pendiente.size() >= configuracion.bytesParaPuntoControl;
+    }
+
+    // escribe el estado completo en un punto de control y vacia el diario. recorrerEstado
+    // (visitar) debe llamar a visitar(usuario, actividad, hora, vencimiento) por cada
+    // actividad; quien llama impide que se anoten registros mientras tanto
+    template <typename RecorrerEstado>
+    bool puntoControl(RecorrerEstado recorrerEstado) {
+        unique_lock bloqueo(cerrojo);
+        hayDurable.wait(bloqueo, [&] { return !escribiendo; }); // espera al grupo en curso
+        escribiendo = true;
+        uint64_t lsnPuntoControl = ultimoLsn;
+        bloqueo.unlock();
+
+        vector<char> datos(begin(firmaPuntoControl), end(firmaPuntoControl));
+        escribirValor(datos, lsnPuntoControl);
+        size_t posicionCantidad = datos.size();
+        escribirValor(datos, uint64_t{0});
+        uint64_t cantidad = 0;
+        recorrerEstado([&](string_view usuario, string_view actividad, time_t hora, time_t vencimiento) {
+            escribirEncolado(datos, usuario, actividad, hora, vencimiento);
+            ++cantidad;
+        });
+        memcpy(datos.data() + posicionCantidad, &cantidad, sizeof(cantidad));
+        escribirValor(datos, sumaControl(datos.data(), datos.size()));
+
+        // se escribe aparte y se renombra para que el punto de control anterior siga valido
+        string temporal = configuracion.ruta + ".ckp.tmp";
+        bool correcto = false;
+        if (FILE* f = fopen(temporal.c_str(), "wb")) {
+            correcto = fwrite(datos.data(), 1, datos.size(), f) == datos.size() && sincronizar(f);
+            fclose(f);
+        }
+        error_code error;
+        if (correcto) filesystem::rename(temporal, configuracion.ruta + ".ckp", error);
+        correcto = correcto && !error;
+        if (correcto) { // el diario anterior ya esta cubierto por el punto de control
+            if (archivo) fclose(archivo);
+            archivo = fopen(configuracion.ruta.c_str(), "wb");
+        }
+
+        bloqueo.lock();
+        if (correcto) {
+            pendiente.clear(); // incluido en el punto de control
+            bytesDiario = 0;
+            lsnDurable = lsnPuntoControl;
+            fallo = !archivo; // el punto de control cubre lo que no llego al diario
+        } else {
+            cerr << "Error: No se pudo escribir el punto de control de " << configuracion.ruta << "." << endl;
+        }
+        escribiendo = false;
+        hayDurable.notify_all();
+        hayTrabajo.notify_one();
+        return correcto && archivo;
+    }
+};
+
+#endif //DIARIO_H
@@ -0,0 +1,295 @@
+#ifndef EXPORTADOR_H
+#define EXPORTADOR_H
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "accesos.h"
+#include "actividades.h"
+using namespace std;
+
+// -----EXPORTACION-----
+// resultado de una exportacion
+struct ResultadoExportacion {
+    bool correcto = false; // false si no se pudo abrir o escribir el destino
+    uint64_t filas = 0; // filas exportadas
+    uint64_t bytes = 0; // bytes escritos
+    double segundos = 0.0; // duracion de la exportacion
+
+    double gbPorSegundo() const {
+        return segundos > 0 ? bytes / segundos / 1e9 : 0.0;
+    }
+};
+
+// escribe en un archivo a traves de un buffer propio de tamaño fijo, en bloques grandes y
+// sin el buffer de stdio, de modo que la memoria no depende del tamaño de los datos
+class EscritorBuffer {
+private:
+    FILE* archivo = nullptr; // destino, o nullptr si no se pudo abrir
+    vector<char> buffer; // datos aun no escritos
+    size_t usados = 0; // bytes ocupados del buffer
+    uint64_t escritos = 0; // bytes entregados al archivo
+    bool fallo = false; // hubo un error de escritura
+
+    void volcar() {
+        if (usados && archivo && fwrite(buffer.data(), 1, usados, archivo) != usados) fallo = true;
+        escritos += usados;
+        usados = 0;
+    }
+
+public:
+    explicit EscritorBuffer(const string& ruta, size_t capacidad = 1 << 20) : buffer(capacidad) {
+        archivo = fopen(ruta.c_str(), "wb");
+        if (archivo) setvbuf(archivo, nullptr, _IONBF, 0); // el buffer ya es nuestro
+    }
+
+    ~EscritorBuffer() {
+        cerrar();
+    }
+
+    EscritorBuffer(const EscritorBuffer&) = delete;
+    EscritorBuffer& operator=(const EscritorBuffer&) = delete;
+
+    bool abierto() const {
+        return archivo != nullptr;
+    }
+
+    void escribir(const void* datos, size_t longitud) {
+        const char* origen = static_cast<const char*>(datos);
+        if (longitud >= buffer.size()) { // bloques grandes van directos al archivo
+            volcar();
+            if (archivo && fwrite(origen, 1, longitud, archivo) != longitud) fallo = true;
+            escritos += longitud;
+            return;
+        }
+        if (usados + longitud > buffer.size()) volcar();
+        memcpy(buffer.data() + usados, origen, longitud);
+        usados += longitud;
+    }
+
+    void escribir(string_view texto) {
+        escribir(texto.data(), texto.size());
+    }
+
+    template <typename T>
+    void escribirValor(T valor) {
+        escribir(&valor, sizeof(T));
+    }
+
+    // escribe un entero en texto sin pasar por un string temporal
+    void escribirNumero(int64_t valor) {
+        char digitos[24];
+        auto [fin, error] = to_chars(digitos, digitos + sizeof(digitos), valor);
+        escribir(digitos, fin - digitos);
+    }
+
+    // vuelca lo pendiente y cierra el archivo; devuelve false si algo fallo
+    bool cerrar() {
+        if (!archivo) return false;
+        volcar();
+        if (fclose(archivo) != 0) fallo = true;
+        archivo = nullptr;
+        return !fallo;
+    }
+
+    uint64_t getEscritos() const {
+        return escritos + usados;
+    }
+};
+
+// escribe un campo CSV, entre comillas solo si contiene separadores, comillas o saltos
+inline void escribirCampoCsv(EscritorBuffer& salida, string_view campo) {
+    if (campo.find_first_of(",\"\n\r") == string_view::npos) {
+        salida.escribir(campo);
+        return;
+    }
+    salida.escribir("\"");
+    for (size_t inicio = 0;;) {
+        size_t comilla = campo.find('"', inicio);
+        salida.escribir(campo.substr(inicio, comilla - inicio));
+        if (comilla == string_view::npos) break;
+        salida.escribir("\"\""); // las comillas se duplican
+        inicio = comilla + 1;
+    }
+    salida.escribir("\"");
+}
+
+// tipo de una columna del formato columnar
+enum class TipoColumna : uint8_t { Entero64 = 1, Byte = 2, Cadena = 3 };
+
+// formato columnar binario: firma "TGPELCOL", version (uint32), numero de columnas (uint32)
+// y por columna su tipo (uint8) y nombre (uint32 longitud + bytes). Despues siguen bloques
+// de hasta filasPorBloque filas: numero de filas (uint32) y cada columna contigua; Entero64
+// ocupa 8 bytes por fila, Byte 1 y Cadena guarda el total de bytes (uint32), el final de
+// cada valor (uint32 por fila) y los bytes. Un bloque de 0 filas cierra el archivo.
+// Todos los numeros en el orden de bytes de la maquina
+class EscritorColumnar {
+public:
+    static constexpr char firma[8] = {'T', 'G', 'P', 'E', 'L', 'C', 'O', 'L'};
+    static constexpr uint32_t version = 1;
+
+private:
+    EscritorBuffer salida; // archivo de destino
+    vector<TipoColumna> tipos; // tipo de cada columna
+    vector<vector<char>> datos; // valores del bloque actual por columna
+    vector<vector<uint32_t>> finales; // final de cada cadena del bloque, por columna
+    size_t filasPorBloque; // filas maximas por bloque
+    uint32_t filasBloque = 0; // filas en el bloque actual
+    uint64_t filas = 0; // filas escritas en total
+
+    void volcarBloque() {
+        if (!filasBloque) return;
+        salida.escribirValor(filasBloque);
+        for (size_t c = 0; c < tipos.size(); ++c) {
+            if (tipos[c] == TipoColumna::Cadena) {
+                salida.escribirValor(static_cast<uint32_t>(datos[c].size()));
+                salida.escribir(finales[c].data(), finales[c].size() * sizeof(uint32_t));
+                finales[c].clear();
+            }
+            salida.escribir(datos[c].data(), datos[c].size());
+            datos[c].clear(); // conserva la capacidad para el siguiente bloque
+        }
+        filasBloque = 0;
+    }
+
+public:
+    EscritorColumnar(const string& ruta, const vector<pair<string, TipoColumna>>& esquema, size_t filasPorBloque = 65536)
+        : salida(ruta), datos(esquema.size()), finales(esquema.size()), filasPorBloque(filasPorBloque) {
+        salida.escribir(firma, sizeof(firma));
+        salida.escribirValor(version);
+        salida.escribirValor(static_cast<uint32_t>(esquema.size()));
+        for (const auto& [nombre, tipo] : esquema) {
+            tipos.push_back(tipo);
+            salida.escribirValor(static_cast<uint8_t>(tipo));
+            salida.escribirValor(static_cast<uint32_t>(nombre.size()));
+            salida.escribir(nombre);
+        }
+    }
+
+    bool abierto() const {
+        return salida.abierto();
+    }
+
+    void entero(size_t columna, int64_t valor) {
+        const char* bytes = reinterpret_cast<const char*>(&valor);
+        datos[columna].insert(datos[columna].end(), bytes, bytes + sizeof(valor));
+    }
+
+    void byte(size_t columna, uint8_t valor) {
+        datos[columna].push_back(static_cast<char>(valor));
+    }
+
+    void cadena(size_t columna, string_view valor) {
+        datos[columna].insert(datos[columna].end(), valor.begin(), valor.end());
+        finales[columna].push_back(static_cast<uint32_t>(datos[columna].size()));
+    }
+
+    // cierra la fila actual; cada columna debe haber recibido un valor
+    void finFila() {
+        ++filas;
+        if (++filasBloque == filasPorBloque) volcarBloque();
+    }
+
+    // escribe el ultimo bloque y el de cierre; devuelve false si algo fallo
+    bool cerrar() {
+        volcarBloque();
+        salida.escribirValor(uint32_t{0});
+        return salida.cerrar();
+    }
+
+    uint64_t getFilas() const {
+        return filas;
+    }
+
+    uint64_t getBytes() const {
+        return salida.getEscritos();
+    }
+};
+
+// formato de exportacion
+enum class FormatoExportacion : unsigned char { Csv, Columnar };
+
+// exporta los accesos (usuario, hora, perfil) en orden cronologico a la ruta indicada
+inline ResultadoExportacion exportarAccesos(const ListaEnlazadaAccesos& accesos, const string& ruta, FormatoExportacion formato) {
+    ResultadoExportacion resultado;
+    auto inicio = chrono::steady_clock::now();
+    if (formato == FormatoExportacion::Csv) {
+        EscritorBuffer salida(ruta);
+        if (!salida.abierto()) return resultado;
+        salida.escribir("usuario,hora,perfil\n");
+        for (const NodoAcceso* nodo = accesos.getCabeza(); nodo; nodo = nodo->siguiente) {
+            escribirCampoCsv(salida, nodo->nombreUsuario);
+            salida.escribir(",");
+            salida.escribirNumero(nodo->horaAcceso);
+            salida.escribir(",");
+            salida.escribirNumero(nodo->perfil);
+            salida.escribir("\n");
+            ++resultado.filas;
+        }
+        resultado.bytes = salida.getEscritos();
+        resultado.correcto = salida.cerrar();
+    } else {
+        EscritorColumnar salida(ruta, {{"usuario", TipoColumna::Cadena}, {"hora", TipoColumna::Entero64}, {"perfil", TipoColumna::Byte}});
+        if (!salida.abierto()) return resultado;
+        for (const NodoAcceso* nodo = accesos.getCabeza(); nodo; nodo = nodo->siguiente) {
+            salida.cadena(0, nodo->nombreUsuario);
+            salida.entero(1, nodo->horaAcceso);
+            salida.byte(2, static_cast<uint8_t>(nodo->perfil));
+            salida.finFila();
+        }
+        resultado.correcto = salida.cerrar();
+        resultado.filas = salida.getFilas();
+        resultado.bytes = salida.getBytes();
+    }
+    resultado.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    return resultado;
+}
+
+// exporta las actividades pendientes (usuario, actividad, hora, vencida) del frente al
+// final; mantiene tomado el cerrojo de la cola mientras escribe
+inline ResultadoExportacion exportarActividades(const ColaActividades& cola, const string& ruta, FormatoExportacion formato) {
+    ResultadoExportacion resultado;
+    auto inicio = chrono::steady_clock::now();
+    if (formato == FormatoExportacion::Csv) {
+        EscritorBuffer salida(ruta);
+        if (!salida.abierto()) return resultado;
+        salida.escribir("usuario,actividad,hora,vencida\n");
+        cola.recorrer([&](const RegistroActividad& registro) {
+            escribirCampoCsv(salida, registro.getUsuario());
+            salida.escribir(",");
+            escribirCampoCsv(salida, registro.getActividad());
+            salida.escribir(",");
+            salida.escribirNumero(registro.hora);
+            salida.escribir(registro.vencida ? ",1\n" : ",0\n");
+            ++resultado.filas;
+        });
+        resultado.bytes = salida.getEscritos();
+        resultado.correcto = salida.cerrar();
+    } else {
+        EscritorColumnar salida(ruta, {{"usuario", TipoColumna::Cadena}, {"actividad", TipoColumna::Cadena},
+                                       {"hora", TipoColumna::Entero64}, {"vencida", TipoColumna::Byte}});
+        if (!salida.abierto()) return resultado;
+        cola.recorrer([&](const RegistroActividad& registro) {
+            salida.cadena(0, registro.getUsuario());
+            salida.cadena(1, registro.getActividad());
+            salida.entero(2, registro.hora);
+            salida.byte(3, registro.vencida);
+            salida.finFila();
+        });
+        resultado.correcto = salida.cerrar();
+        resultado.filas = salida.getFilas();
+        resultado.bytes = salida.getBytes();
+    }
+    resultado.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    return resultado;
+}
+
+#endif // EXPORTADOR_H
@@ -0,0 +1,221 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include "accesos.h"
+#include "actividades.h"
+using namespace std;
+
+// -----INFORMES INCREMENTALES-----
+// escapa la barra invertida, el tabulador y los saltos de linea de un campo de texto, para
+// que un nombre o una actividad escrita a mano no desplacen las columnas del estado
+inline string escaparCampo(string_view campo) {
+    string escapado;
+    escapado.reserve(campo.size());
+    for (char c : campo) {
+        switch (c) {
+            case '\\': escapado += "\\\\"; break;
+            case '\t': escapado += "\\t"; break;
+            case '\n': escapado += "\\n"; break;
+            case '\r': escapado += "\\r"; break;
+            default: escapado += c;
+        }
+    }
+    return escapado;
+}
+
+// deshace escaparCampo; devuelve false si hay una secuencia de escape desconocida
+inline bool desescaparCampo(string_view campo, string& resultado) {
+    resultado.clear();
+    for (size_t i = 0; i < campo.size(); ++i) {
+        if (campo[i] != '\\') {
+            resultado += campo[i];
+            continue;
+        }
+        if (++i == campo.size()) return false;
+        switch (campo[i]) {
+            case '\\': resultado += '\\'; break;
+            case 't': resultado += '\t'; break;
+            case 'n': resultado += '\n'; break;
+            case 'r': resultado += '\r'; break;
+            default: return false;
+        }
+    }
+    return true;
+}
+
+// lee un entero que ocupe todo el campo; devuelve false si sobra o falta algo
+template <typename Entero>
+bool leerEntero(string_view campo, Entero& valor) {
+    auto [fin, error] = from_chars(campo.data(), campo.data() + campo.size(), valor);
+    return error == errc() && fin == campo.data() + campo.size() && !campo.empty();
+}
+
+// estado que un informe incremental deja para el siguiente: hasta donde se proceso y los
+// totales acumulados. Se guarda como texto, una entrada por linea con campos separados por
+// tabuladores; los textos van escapados con escaparCampo
+struct EstadoIncremental {
+    time_t cursor = 0; // todo lo anterior a esta hora ya se proceso
+    uint64_t lista = 0; // identificador de la lista de accesos procesada
+    uint64_t posicion = 0; // accesos de esa lista ya procesados, en orden de insercion
+    map<string, uint64_t> accesos; // accesos acumulados por usuario
+    map<pair<string, string>, uint64_t> actividades; // asignaciones acumuladas por (usuario, actividad)
+
+    // carga el estado de la ruta; si no existe deja el estado vacio. Devuelve false, con el
+    // estado vacio, si el archivo existe pero no se puede leer o alguna linea no es valida
+    bool cargar(const string& ruta) {
+        *this = EstadoIncremental();
+        ifstream archivo(ruta);
+        if (!archivo) return !filesystem::exists(ruta);
+        string linea;
+        while (getline(archivo, linea)) {
+            if (!cargarLinea(linea)) {
+                *this = EstadoIncremental();
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    // interpreta una linea del estado; devuelve false si no es valida
+    bool cargarLinea(string_view linea) {
+        vector<string_view> campos;
+        for (size_t inicio = 0;;) {
+            size_t fin = linea.find('\t', inicio);
+            campos.push_back(linea.substr(inicio, fin - inicio));
+            if (fin == string_view::npos) break;
+            inicio = fin + 1;
+        }
+        string_view tipo = campos[0];
+        string usuario, actividad;
+        if (tipo == "cursor" && campos.size() == 2) {
+            int64_t valor;
+            if (!leerEntero(campos[1], valor)) return false;
+            cursor = static_cast<time_t>(valor);
+            return true;
+        }
+        if (tipo == "lista" && campos.size() == 2) return leerEntero(campos[1], lista);
+        if (tipo == "posicion" && campos.size() == 2) return leerEntero(campos[1], posicion);
+        if (tipo == "acceso" && campos.size() == 3) {
+            uint64_t n;
+            if (!desescaparCampo(campos[1], usuario) || !leerEntero(campos[2], n)) return false;
+            accesos[usuario] = n;
+            return true;
+        }
+        if (tipo == "actividad" && campos.size() == 4) {
+            uint64_t n;
+            if (!desescaparCampo(campos[1], usuario) || !desescaparCampo(campos[2], actividad) || !leerEntero(campos[3], n)) return false;
+            actividades[{usuario, actividad}] = n;
+            return true;
+        }
+        return false; // linea desconocida: el archivo no es un estado valido
+    }
+
+public:
+    // guarda el estado en un archivo temporal y lo renombra, para no dejarlo a medias
+    bool guardar(const string& ruta) const {
+        string temporal = ruta + ".tmp";
+        {
+            ofstream archivo(temporal);
+            if (!archivo) return false;
+            archivo << "cursor\t" << cursor << "\n";
+            archivo << "lista\t" << lista << "\n";
+            archivo << "posicion\t" << posicion << "\n";
+            for (const auto& [usuario, n] : accesos) archivo << "acceso\t" << escaparCampo(usuario) << "\t" << n << "\n";
+            for (const auto& [par, n] : actividades) {
+                archivo << "actividad\t" << escaparCampo(par.first) << "\t" << escaparCampo(par.second) << "\t" << n << "\n";
+            }
+            if (!archivo.flush()) return false;
+        }
+        error_code error;
+        filesystem::rename(temporal, ruta, error);
+        return !error;
+    }
+};
+
+// genera un informe solo con lo nuevo desde el anterior y lo suma a los totales del estado
+// guardado en rutaEstado. Muestra y escribe en informe_incremental.txt tanto lo nuevo como
+// los totales, y guarda el estado con el cursor en ahora y la posicion al final de la
+// columna de accesos.
+// Si la lista es la del informe anterior, los accesos nuevos son los insertados despues de
+// la posicion guardada, aunque su hora sea anterior al cursor, y no se recorre el resto de
+// la columna. Con otra lista (otra ejecucion) la posicion no sirve: se usan los accesos con
+// hora en [cursor, ahora), y los anteriores al cursor no se distinguen de los ya contados.
+// Las asignaciones nuevas son las pendientes con hora en [cursor, ahora); las que se
+// extrajeron de la cola antes de un informe no aparecen en el
+inline void generarInformeIncremental(const ListaEnlazadaAccesos& accesos, const ColaActividades& cola,
+                                      const string& rutaEstado = "estado_informes.txt", time_t ahora = time(0)) {
+    EstadoIncremental estado;
+    if (!estado.cargar(rutaEstado)) {
+        cout << "Error: El estado de informes " << rutaEstado << " no es valido." << endl; // mensaje de error
+        return;
+    }
+    time_t desde = estado.cursor;
+    size_t filas = accesos.getColumnaHoras().size();
+
+    // solo lo nuevo: la columna de horas localiza los accesos sin recorrer la lista
+    map<string, uint64_t> nuevosAccesos;
+    auto contar = [&](const NodoAcceso* nodo) { nuevosAccesos[nodo->nombreUsuario]++; };
+    if (estado.lista == accesos.getIdentificador() && estado.posicion <= filas) {
+        accesos.recorrerDesde(estado.posicion, contar); // solo la cola de la columna
+    } else if (ahora > desde) {
+        accesos.recorrerPorHora(desde, ahora, contar);
+    }
+    map<pair<string, string>, uint64_t> nuevasActividades;
+    if (ahora > desde) {
+        cola.recorrer([&](const RegistroActividad& registro) {
+            if (registro.hora >= desde && registro.hora < ahora) nuevasActividades[{registro.getUsuario(), registro.getActividad()}]++;
+        });
+    }
+    estado.cursor = max(ahora, desde);
+    estado.lista = accesos.getIdentificador();
+    estado.posicion = filas;
+    if (nuevosAccesos.empty() && nuevasActividades.empty()) {
+        cout << "No hay datos nuevos desde el ultimo informe." << endl;
+        if (!estado.guardar(rutaEstado)) { // conserva la posicion para el siguiente informe
+            cout << "Error: No se pudo guardar el estado de informes en " << rutaEstado << "." << endl; // mensaje de error
+        }
+        return;
+    }
+
+    for (const auto& [usuario, n] : nuevosAccesos) estado.accesos[usuario] += n;
+    for (const auto& [par, n] : nuevasActividades) estado.actividades[par] += n;
+
+    ostringstream informe;
+    informe << "Informe incremental desde " << (desde ? ctime(&desde) : "el inicio\n");
+    informe << "Nuevos accesos:\n";
+    for (const auto& [usuario, n] : nuevosAccesos) informe << usuario << ": +" << n << " (total " << estado.accesos[usuario] << ")\n";
+    informe << "Nuevas actividades:\n";
+    for (const auto& [par, n] : nuevasActividades) {
+        informe << par.first << ", " << par.second << ": +" << n << " (total " << estado.actividades[par] << ")\n";
+    }
+    informe << "Totales acumulados:\n";
+    for (const auto& [usuario, n] : estado.accesos) informe << usuario << ": " << n << " accesos\n";
+    for (const auto& [par, n] : estado.actividades) informe << par.first << ", " << par.second << ": " << n << " asignaciones\n";
+
+    cout << informe.str();
+    ofstream archivo("informe_incremental.txt"); // guarda el informe en un archivo
+    archivo << informe.str();
+    archivo.close(); // cierra el archivo
+
+    if (!estado.guardar(rutaEstado)) {
+        cout << "Error: No se pudo guardar el estado de informes en " << rutaEstado << "." << endl; // mensaje de error
+    }
+}
+
+#endif // INCREMENTAL_H
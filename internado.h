@@ -0,0 +1,63 @@
+#ifndef INTERNADO_H
+#define INTERNADO_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+using namespace std;
+
+// -----INTERNADO DE CADENAS-----
+// asigna a cada cadena distinta un id compacto y consecutivo; las cadenas se guardan una
+// sola vez y el indice apunta a ellas, por lo que los ids y referencias son estables.
+// Puede usarse desde varios hilos: las consultas comparten el cerrojo y solo el registro
+// de una cadena nueva lo toma en exclusiva
+class TablaInternado {
+public:
+    static constexpr uint32_t sinId = UINT32_MAX; // id devuelto cuando la cadena no existe
+
+private:
+    deque<string> valores; // cadena de cada id; deque no invalida referencias al crecer
+    unordered_map<string_view, uint32_t> ids; // id de cada cadena
+    mutable shared_mutex cerrojo; // protege valores e ids
+
+public:
+    // devuelve el id de una cadena, registrandola si es nueva
+    uint32_t internar(string_view valor) {
+        uint32_t existente = buscar(valor);
+        if (existente != sinId) return existente;
+        unique_lock bloqueo(cerrojo);
+        auto encontrado = ids.find(valor); // otro hilo pudo registrarla mientras tanto
+        if (encontrado != ids.end()) return encontrado->second;
+        uint32_t id = static_cast<uint32_t>(valores.size());
+        valores.emplace_back(valor);
+        ids.emplace(valores.back(), id);
+        return id;
+    }
+
+    // devuelve el id de una cadena o sinId si no esta registrada
+    uint32_t buscar(string_view valor) const {
+        shared_lock bloqueo(cerrojo);
+        auto encontrado = ids.find(valor);
+        return encontrado == ids.end() ? sinId : encontrado->second;
+    }
+
+    // devuelve la cadena de un id
+    const string& valor(uint32_t id) const {
+        shared_lock bloqueo(cerrojo);
+        return valores[id];
+    }
+
+    size_t size() const {
+        shared_lock bloqueo(cerrojo);
+        return valores.size();
+    }
+};
+
+// nombres de usuario (normalizados) compartidos por todas las colas
+inline TablaInternado tablaUsuarios;
+
+#endif //INTERNADO_H
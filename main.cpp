@@ -3,300 +3,27 @@
 #include <ctime>
 #include <cstdlib>
 #include <memory>
-#include <map>
-#include <fstream>
+#include "perfiles.h"
+#include "seguridad.h"
+#include "accesos.h"
+#include "actividades.h"
+#include "registro_colas.h"
+#include "analisis.h"
+#include "exportador.h"
+#include "incremental.h"
+#include "consultas.h"
 using namespace std;
 
-// convierte una cadena a minúsculas
-string toLowerCase(const string& str) {
-    string lowerStr = str; // copia de la cadena original
-    for (char& c : lowerStr) {
-        c = tolower(c); // convierte cada carácter a minúscula
-    }
-    return lowerStr; // devuelve la cadena en minúsculas
-}
-
-// prototipo para generar contraseñas diarias
-string generarContrasenaDiaria();
-
-// -----GESTION DE ACCESOS-----
-// clase NodoAcceso representa un nodo en la lista de accesos
-class NodoAcceso {
-public:
-    string nombreUsuario; // nombre del usuario
-    time_t horaAcceso; // hora de acceso
-    int perfil; // perfil del usuario (1: usuario, 2: supervisor, 3: analista)
-    string contrasena; // contraseña del usuario
-    string telefono; // teléfono del usuario
-    NodoAcceso* siguiente; // puntero al siguiente nodo
-
-    // constructor para inicializar los atributos del nodo
-    NodoAcceso(const string& nombre, time_t hora, int p, const string& pass = "", const string& phone = "")
-        : nombreUsuario(nombre), horaAcceso(hora), perfil(p), contrasena(pass), telefono(phone), siguiente(nullptr) {}
-};
-
-// clase ListaEnlazadaAccesos gestiona una lista enlazada de accesos
-class ListaEnlazadaAccesos {
-private:
-    NodoAcceso* cabeza; // puntero al primer nodo de la lista
-
-    // inserta un nodo en orden cronológico usando recursión
-    void insertarRecursivo(NodoAcceso*& actual, NodoAcceso* nuevo) {
-        if (!actual || difftime(nuevo->horaAcceso, actual->horaAcceso) < 0) { // si la lista está vacía o el nuevo nodo es más antiguo
-            nuevo->siguiente = actual; // enlaza el nuevo nodo al inicio
-            actual = nuevo; // actualiza la cabeza de la lista
-            return;
-        }
-        insertarRecursivo(actual->siguiente, nuevo); // continúa con el siguiente nodo
-    }
-
-    // busca un nodo por nombre o por hora usando recursión
-    NodoAcceso* buscarRecursivo(NodoAcceso* actual, const string& usuario, time_t hora, bool buscarPorUsuario) {
-        if (!actual) { // si no hay más nodos
-            cout << "Error: No se encontro el registro correspondiente." << endl; // mensaje de error
-            return nullptr; // devuelve un puntero nulo
-        }
-        if (buscarPorUsuario && toLowerCase(actual->nombreUsuario) == toLowerCase(usuario)) { // compara nombres en minúsculas
-            return actual; // devuelve el nodo encontrado
-        } else if (!buscarPorUsuario && difftime(actual->horaAcceso, hora) == 0) { // compara por hora
-            return actual; // devuelve el nodo encontrado
-        }
-        return buscarRecursivo(actual->siguiente, usuario, hora, buscarPorUsuario); // recursión para buscar en el siguiente nodo
-    }
-
-    // muestra los nodos de la lista usando recursión
-    void mostrarRecursivo(NodoAcceso* actual) {
-        if (!actual) return; // si no hay más nodos, detiene la recursión
-        cout << "Usuario: " << actual->nombreUsuario
-             << ", Hora: " << ctime(&(actual->horaAcceso))
-             << ", Perfil: " << actual->perfil << endl; // muestra los detalles del nodo
-        mostrarRecursivo(actual->siguiente); // muestra el siguiente nodo
-    }
-
-public:
-    ListaEnlazadaAccesos() : cabeza(nullptr) {} // inicializa una lista vacía
-
-    ~ListaEnlazadaAccesos() {
-        while (cabeza) { // mientras haya nodos en la lista
-            NodoAcceso* temp = cabeza; // almacena el nodo actual
-            cabeza = cabeza->siguiente; // pasa al siguiente nodo
-            delete temp; // elimina el nodo actual
-        }
-    }
-    // devuelve el puntero a la cabeza de la lista
-    NodoAcceso* getCabeza() const {
-        return cabeza;
-    }
-
-    // inserta un nodo en la lista
-    void insertar(const string& nombre, time_t hora, int perfil, const string& pass = "", const string& phone = "") {
-        NodoAcceso* nuevo = new NodoAcceso(nombre, hora, perfil, pass, phone); // crea un nuevo nodo
-        insertarRecursivo(cabeza, nuevo); // llama a la función recursiva para insertar el nodo
-    }
-
-    // busca un nodo por nombre
-    NodoAcceso* buscarPorNombre(const string& usuario) {
-        return buscarRecursivo(cabeza, usuario, 0, true); // llama a la función recursiva para buscar por nombre
-    }
-
-    // busca un nodo por hora
-    NodoAcceso* buscarPorHora(time_t hora) {
-        return buscarRecursivo(cabeza, "", hora, false); // llama a la función recursiva para buscar por hora
-    }
-
-
-    // valida las credenciales de un usuario
-    bool validarCredenciales(const string& usuario, const string& contrasena = "", const string& telefono = "", const string& contrasenaAleatoria = "") {
-        NodoAcceso* nodo = buscarPorNombre(usuario); // busca al usuario por nombre
-        if (!nodo) { // si no encuentra el nodo
-            cout << "Error: Usuario no registrado." << endl; // mensaje de error
-            return false;
-        }
-        if (nodo->contrasena != contrasena) { // verifica la contraseña
-            cout << "Error: Contrasenia incorrecta." << endl; // mensaje de error
-            return false;
-        }
-        if (nodo->perfil == 3 && nodo->telefono != telefono) { // verifica el teléfono para el perfil 3
-            cout << "Error: Telefono incorrecto." << endl; // mensaje de error
-            return false;
-        }
-        if (nodo->perfil == 3 && !contrasenaAleatoria.empty() && contrasenaAleatoria != generarContrasenaDiaria()) { // verifica la contraseña aleatoria para el perfil 3
-            cout << "Error: Contrasenia aleatoria incorrecta." << endl; // mensaje de error
-            return false;
-        }
-        cout << "Credenciales validas para el usuario " << usuario << "." << endl; // mensaje de éxito
-        return true; // devuelve verdadero si las credenciales son válidas
-    }
-
-    // muestra todos los nodos de la lista
-    void mostrar() {
-        mostrarRecursivo(cabeza); // llama a la función recursiva para mostrar los nodos
-    }
-};
-
-// -----GESTION DE SEGURIDAD-----
-// clase para gestionar la pila de seguridad
-class PilaSeguridad {
-private:
-    string niveles[3] = {"Bajo", "Medio", "Alto"}; // niveles de seguridad
-
-public:
-    // ajusta el nivel de seguridad según el perfil
-    void ajustarNivel(int perfil) {
-        if (perfil == 1) { // perfil de usuario general
-            niveles[0] = "Bajo";
-            niveles[1] = "Medio";
-            niveles[2] = "Alto";
-        } else if (perfil == 2) { // perfil de supervisor
-            niveles[0] = "Medio";
-            niveles[1] = "Bajo";
-            niveles[2] = "Alto";
-        } else if (perfil == 3) { // perfil de analista
-            niveles[0] = "Alto";
-            niveles[1] = "Medio";
-            niveles[2] = "Bajo";
-        }
-    }
-
-    // muestra los niveles de seguridad en la pila
-    void mostrarPila() {
-        cout << "Niveles de seguridad en la pila:" << endl; // encabezado
-        for (const string& nivel : niveles) { // recorre los niveles
-            cout << nivel << endl; // muestra cada nivel
-        }
-    }
-};
-
-// genera una contraseña diaria basada en la fecha
-string generarContrasenaDiaria() {
-    time_t ahora = time(0); // obtiene la hora actual
-    tm* tiempoLocal = localtime(&ahora); // convierte la hora a tiempo local
-
-    // usa el dia, mes y año como semilla para generar una contraseña
-    int semilla = tiempoLocal->tm_year * 10000 + (tiempoLocal->tm_mon + 1) * 100 + tiempoLocal->tm_mday;
-    srand(semilla); // establece la semilla
-
-    const string caracteres = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"; // caracteres posibles para la contraseña
-    string contrasena;
-    for (int i = 0; i < 8; ++i) {
-        contrasena += caracteres[rand() % caracteres.size()]; // selecciona caracteres aleatorios
-    }
-    return contrasena; // devuelve la contraseña generada
-}
-
-// -------ACTIVIDADES-------
-// nodo para actividades
-class NodoCola {
-public:
-    string usuario; // usuario al que pertenece la actividad
-    string actividad; // descripcion de la actividad
-    time_t hora; // hora en que se asigna la actividad
-    NodoCola* siguiente; // puntero al siguiente nodo
-
-    NodoCola(const string& user, const string& act, time_t t)
-        : usuario(user), actividad(act), hora(t), siguiente(nullptr) {}
-};
-
-// cola para gestionar actividades
-class ColaActividades {
-private:
-    NodoCola* frente; // primer nodo de la cola
-    NodoCola* final; // ultimo nodo de la cola
-
-    // muestra las actividades de forma recursiva
-    void mostrarRecursivo(NodoCola* actual) {
-        if (!actual) return; // si no hay mas nodos, termina
-        cout << "Actividad: " << actual->actividad
-             << ", Asignada a: " << actual->usuario
-             << ", Hora: " << ctime(&(actual->hora)); // muestra los detalles de la actividad
-        mostrarRecursivo(actual->siguiente); // pasa al siguiente nodo
-    }
-
-public:
-    ColaActividades() : frente(nullptr), final(nullptr) {} // inicializa una cola vacia
-
-    ~ColaActividades() {
-        while (frente) { // mientras haya nodos en la cola
-            NodoCola* temp = frente; // almacena el nodo actual
-            frente = frente->siguiente; // pasa al siguiente nodo
-            delete temp; // elimina el nodo actual
-        }
-    }
-
-    // obtiene el primer nodo de la cola
-    NodoCola* getFrente() const {
-        return frente;
-    }
-
-
-    // agrega una actividad a la cola
-    void enqueue(const string& usuario, const string& actividad) {
-        time_t ahora = time(0);
-        NodoCola* nuevo = new NodoCola(toLowerCase(usuario), actividad, ahora); // Normalizamos el nombre
-        if (!final) {
-            frente = final = nuevo;
-        } else {
-            final->siguiente = nuevo;
-            final = nuevo;
-        }
-    }
-
-    // elimina la actividad mas antigua de la cola
-    void dequeue() {
-        if (!frente) { // si la cola esta vacia
-            cout << "No hay actividades para eliminar." << endl; // mensaje de error
-            return;
-        }
-        NodoCola* temp = frente; // almacena el nodo actual
-        frente = frente->siguiente; // pasa al siguiente nodo
-        if (!frente) final = nullptr; // si la cola queda vacia, actualiza el puntero final
-        delete temp; // elimina el nodo actual
-    }
-
-    // muestra las actividades asignadas a un usuario
-    void mostrar(const string& usuario) {
-        if (!frente) {
-            cout << "No hay actividades en la cola general." << endl;
-            return;
-        }
-
-        NodoCola* actual = frente;
-        bool hayActividades = false;
-
-        cout << "Recorriendo la cola para verificar actividades asignadas..." << endl;
-        while (actual) {
-            cout << "Verificando actividad: Usuario: " << actual->usuario
-                 << ", Actividad: " << actual->actividad << endl;
-
-            if (toLowerCase(actual->usuario) == toLowerCase(usuario)) {
-                cout << "- Actividad: " << actual->actividad
-                     << ", Hora: " << ctime(&(actual->hora)) << endl;
-                hayActividades = true;
-            }
-            actual = actual->siguiente;
-        }
-
-        if (!hayActividades) {
-            cout << "No hay actividades asignadas para " << usuario << "." << endl;
-        }
-    }
-
-    // verifica si un usuario tiene actividades asignadas
-    bool tieneActividades(const string& usuario) {
-        NodoCola* actual = frente;
-        while (actual) {
-            if (actual->usuario == usuario) {
-                return true; // encontro una actividad para el usuario
-            }
-            actual = actual->siguiente;
-        }
-        return false; // no encontro actividades para el usuario
-    }
-};
-
 // Declaración global de colaGeneral
 ColaActividades colaGeneral;
 
+// colas propias de cada supervisor, conservadas entre sesiones: cada registro es el
+// seguimiento de una actividad que el supervisor asigno, con el usuario que la recibio
+RegistroColas colasSupervisores;
+
+// vigila las asignaciones de la cola general en una ventana de 10 minutos
+DetectorSospechosas detectorSospechosas(600, 2);
+
 // funcion para asignar actividad automaticamente
 void asignarActividadAutomaticamente(ListaEnlazadaAccesos& accesos, ColaActividades& colaGeneral, const string& usuario) {
     NodoAcceso* nodo = accesos.buscarPorNombre(usuario); // busca el nodo del usuario por nombre
@@ -305,24 +32,26 @@ void asignarActividadAutomaticamente(ListaEnlazadaAccesos& accesos, ColaActivida
         return; // termina la funcion
     }
 
-    // lista de actividades predeterminadas
-    string actividades[] = {
-        "Actualizar datos personales.", // actividad 1
-        "Configurar autenticacion en dos pasos.", // actividad 2
-        "Revisar historial de accesos.", // actividad 3
-        "Aceptar terminos y condiciones." // actividad 4
-    };
+    // selecciona una actividad predefinida aleatoria del catalogo
+    uint32_t actividadSeleccionada = CatalogoActividades::idPredefinida(rand() % CatalogoActividades::predefinidas.size());
 
-    if (colaGeneral.tieneActividades(usuario)) { // verifica si el usuario ya tiene actividades asignadas
-        cout << "El usuario " << usuario << " ya tiene actividades pendientes." << endl; // informa al usuario
+    // agrega la actividad a la cola del usuario salvo que ya la tenga pendiente
+    ResultadoEncolado resultado = colaGeneral.enqueueUnico(usuario, actividadSeleccionada);
+    if (resultado == ResultadoEncolado::Duplicada) {
+        cout << "El usuario " << usuario << " ya tiene pendiente: "
+             << catalogoActividades.descripcion(actividadSeleccionada) << endl; // informa al usuario
         return; // termina la funcion
     }
-
-    int actividadIndex = rand() % 4; // selecciona una actividad aleatoria de la lista
-    string actividadSeleccionada = actividades[actividadIndex]; // asigna la actividad seleccionada
-
-    colaGeneral.enqueue(usuario, actividadSeleccionada); // agrega la actividad a la cola del usuario
-    cout << "Actividad asignada automaticamente a " << usuario << ": " << actividadSeleccionada << endl; // confirma la asignacion
+    if (resultado == ResultadoEncolado::Rechazada) {
+        cout << "Error: La cola general esta llena; no se asigno actividad a " << usuario << "." << endl; // la cola rechaza la actividad
+        return; // termina la funcion
+    }
+    if (resultado == ResultadoEncolado::NoDurable) {
+        cout << "Error: La actividad de " << usuario << " no se pudo guardar en el diario." << endl; // se perderia al reiniciar
+        return; // termina la funcion
+    }
+    cout << "Actividad asignada automaticamente a " << usuario << ": "
+         << catalogoActividades.descripcion(actividadSeleccionada) << endl; // confirma la asignacion
 }
 
 // -----MENUS-----
@@ -334,7 +63,8 @@ void menuUsuario() {
 
 // menu para asignar actividades
 void asignarActividad(unique_ptr<ColaActividades>& cola, const string& usuario, const string& actividad, int perfilUsuario) {
-    if (perfilUsuario != 1 && perfilUsuario != 2) { // valida que el perfil sea permitido
+    const DescriptorPerfil* perfil = buscarPerfil(perfilUsuario);
+    if (!perfil || !perfil->recibeActividades) { // valida que el perfil sea permitido
         cout << "Error: No tienes permiso para asignar actividades a este perfil." << endl; // mensaje de error
         return; // termina la funcion
     }
@@ -345,7 +75,8 @@ void asignarActividad(unique_ptr<ColaActividades>& cola, const string& usuario,
 
 // revisa actividades asignadas a un usuario
 void revisarActividades(unique_ptr<ColaActividades>& cola, const string& usuario, int perfilUsuario) {
-    if (perfilUsuario != 1) { // valida que el perfil tenga permisos
+    const DescriptorPerfil* perfil = buscarPerfil(perfilUsuario);
+    if (!perfil || !perfil->actividadesRevisables) { // valida que el perfil tenga permisos
         cout << "Error: No tienes permiso para revisar actividades de este perfil." << endl; // mensaje de error
         return; // termina la funcion
     }
@@ -361,8 +92,37 @@ void gestionarActividadesPropias(ColaActividades* cola, const string& usuario) {
 }
 
 // -----MENU SUPERVISOR-----
+// muestra los seguimientos del supervisor. Los del frente cuya actividad ya no esta
+// pendiente en la cola general se dan por completados y se eliminan
+void revisarSeguimientos(ColaActividades& colaGeneral, ColaActividades& colaSupervisor, const string& supervisor) {
+    size_t completados = 0; // seguimientos completados al frente de la cola
+    bool enFrente = true;
+    colaSupervisor.recorrer([&](const RegistroActividad& registro) {
+        enFrente = enFrente && !colaGeneral.tieneActividad(registro.getUsuario(), registro.getActividad());
+        completados += enFrente;
+    });
+    colaSupervisor.drenar(completados, [](const RegistroActividad&) {}); // no queda nada que seguir
+
+    if (!colaSupervisor.tamano()) {
+        cout << "No tienes actividades pendientes de seguimiento, " << supervisor << "." << endl;
+        return;
+    }
+    colaSupervisor.recorrer([&](const RegistroActividad& registro) {
+        bool pendiente = colaGeneral.tieneActividad(registro.getUsuario(), registro.getActividad());
+        cout << "- Seguimiento: " << registro.getActividad() << " asignada a " << registro.getUsuario()
+             << (pendiente ? "" : " [COMPLETADA]") << (registro.vencida ? " [VENCIDA]" : "")
+             << ", Hora: " << ctime(&(registro.hora));
+    });
+}
+
+// nivel de seguridad que exige cada opcion del menu del supervisor
+constexpr NivelSeguridad nivelOpcionSupervisor(int opcion) {
+    return opcion == 1 || opcion == 2 ? NivelSeguridad::Medio : NivelSeguridad::Bajo; // asignar y revisar afectan a otros usuarios
+}
+
 // menu para supervisores
-void menuSupervisor(ListaEnlazadaAccesos& accesos, ColaActividades* colaGeneral, ColaActividades* colaSupervisor, const string& supervisor) {
+void menuSupervisor(ListaEnlazadaAccesos& accesos, ColaActividades* colaGeneral, ColaActividades* colaSupervisor, const string& supervisor,
+                    PilaSeguridad& pila) {
     int opcion; // opcion seleccionada
 
     do {
@@ -374,14 +134,23 @@ void menuSupervisor(ListaEnlazadaAccesos& accesos, ColaActividades* colaGeneral,
         cout << "Selecciona una opcion: "; // prompt de seleccion
         cin >> opcion; // lee la opcion seleccionada
 
+        ContextoSeguridad contexto(pila, nivelOpcionSupervisor(opcion)); // apila el nivel de la peticion mientras se atiende
+        if (!contexto.permitido()) {
+            cout << "Error: Tu nivel de seguridad no permite esta opcion." << endl; // mensaje de error
+            continue;
+        }
         switch (opcion) {
             case 1: { // asignar actividad
-                string usuario, actividad;
+                string usuario, actividad, plazo;
                 cout << "Introduce el nombre del usuario: "; // solicita el nombre del usuario
                 cin.ignore();
                 getline(cin, usuario); // lee el nombre del usuario
                 cout << "Introduce la actividad a asignar: "; // solicita la actividad
                 getline(cin, actividad); // lee la actividad
+                cout << "Introduce el plazo en minutos (0 sin plazo): "; // solicita el plazo
+                getline(cin, plazo); // lee el plazo
+                int minutos = atoi(plazo.c_str());
+                time_t vencimiento = minutos > 0 ? time(0) + minutos * 60 : 0; // momento en que vence
 
                 NodoAcceso* nodoUsuario = accesos.buscarPorNombre(usuario); // busca al usuario por nombre
                 if (!nodoUsuario) { // verifica si el usuario no existe
@@ -389,11 +158,20 @@ void menuSupervisor(ListaEnlazadaAccesos& accesos, ColaActividades* colaGeneral,
                 } else if (nodoUsuario->perfil != 1) { // verifica si el perfil no es de usuario general
                     cout << "Error: Solo puedes asignar actividades a usuarios generales." << endl; // mensaje de error
                 } else {
-                    if (colaGeneral->tieneActividades(usuario)) { // verifica si el usuario ya tiene actividades
-                        cout << "El usuario " << usuario << " ya tiene actividades pendientes. No se asignaran nuevas." << endl; // mensaje de error
+                    uint32_t idActividad = catalogoActividades.internar(actividad);
+                    ResultadoEncolado resultado = colaGeneral->enqueueUnico(usuario, idActividad, vencimiento); // asigna la actividad si no la tiene ya
+                    if (resultado == ResultadoEncolado::Duplicada) {
+                        cout << "El usuario " << usuario << " ya tiene pendiente esa actividad. No se asignara de nuevo." << endl; // mensaje de error
+                    } else if (resultado == ResultadoEncolado::Rechazada) {
+                        cout << "Error: La cola general esta llena. Intentalo mas tarde." << endl; // la cola rechaza la actividad
                     } else {
-                        colaGeneral->enqueue(usuario, actividad); // asigna la actividad
-                        cout << "Actividad asignada a " << usuario << ": " << actividad << endl; // confirma la asignacion
+                        if (resultado == ResultadoEncolado::NoDurable) {
+                            cout << "Error: La actividad se asigno pero no se pudo guardar en el diario." << endl; // se perderia al reiniciar
+                        } else {
+                            cout << "Actividad asignada a " << usuario << ": " << actividad << endl; // confirma la asignacion
+                        }
+                        // la actividad esta en la cola general aunque no sea durable: anota el seguimiento con el mismo plazo
+                        colaSupervisor->enqueueUnico(usuario, idActividad, vencimiento);
                     }
                 }
                 break;
@@ -408,7 +186,7 @@ void menuSupervisor(ListaEnlazadaAccesos& accesos, ColaActividades* colaGeneral,
                 break;
             }
             case 3: { // revisar actividades propias
-                colaSupervisor->mostrar(supervisor); // muestra las actividades propias
+                revisarSeguimientos(*colaGeneral, *colaSupervisor, supervisor); // muestra las actividades propias
                 break;
             }
             case 4:
@@ -420,92 +198,150 @@ void menuSupervisor(ListaEnlazadaAccesos& accesos, ColaActividades* colaGeneral,
     } while (opcion != 4); // repite hasta que se seleccione salir
 }
 
-// -----ANALISTA-----
-// funcion recursiva para contar accesos
-void contarAccesosRecursivo(NodoAcceso* actual, map<string, int>& conteos) {
-    if (!actual) return; // si no hay mas nodos, termina
-    conteos[actual->nombreUsuario]++; // incrementa el conteo para el usuario actual
-    contarAccesosRecursivo(actual->siguiente, conteos); // pasa al siguiente nodo
-}
-
-// genera estadisticas de accesos
-void generarEstadisticasAccesos(ListaEnlazadaAccesos& accesos) {
-    map<string, int> conteos; // mapa para almacenar conteos
-    contarAccesosRecursivo(accesos.getCabeza(), conteos); // cuenta accesos recursivamente
-
-    cout << "Estadisticas de accesos:\n"; // encabezado
-    for (const auto& par : conteos) { // recorre los conteos
-        cout << par.first << ": " << par.second << " accesos\n"; // muestra el conteo para cada usuario
-    }
-
-    // guarda el informe en un archivo
-    ofstream archivo("informe_accesos.txt");
-    archivo << "Informe de Accesos:\n";
-    archivo << "Total de accesos: " << conteos.size() << "\n";
-    for (const auto& par : conteos) {
-        archivo << par.first << ": " << par.second << " accesos\n";
-    }
-    archivo.close(); // cierra el archivo
+// -----MENU ANALISTA-----
+// menú interactivo para el analista
+// exporta accesos o actividades al formato y la ruta que elija el analista
+void exportarDatos(ListaEnlazadaAccesos& accesos, ColaActividades& cola) {
+    int datos, formato;
+    string ruta;
+    cout << "Datos a exportar (1: accesos, 2: actividades): ";
+    cin >> datos;
+    cout << "Formato (1: CSV, 2: columnar binario): ";
+    cin >> formato;
+    cout << "Ruta de destino: ";
+    cin >> ruta;
+    if ((datos != 1 && datos != 2) || (formato != 1 && formato != 2)) {
+        cout << "Error: Opcion de exportacion no valida." << endl; // mensaje de error
+        return;
+    }
+
+    FormatoExportacion elegido = formato == 1 ? FormatoExportacion::Csv : FormatoExportacion::Columnar;
+    ResultadoExportacion resultado = datos == 1 ? exportarAccesos(accesos, ruta, elegido) : exportarActividades(cola, ruta, elegido);
+    if (!resultado.correcto) {
+        cout << "Error: No se pudo escribir " << ruta << "." << endl; // mensaje de error
+        return;
+    }
+    cout << "Exportadas " << resultado.filas << " filas (" << resultado.bytes << " bytes) a " << ruta << " en "
+         << resultado.segundos << " s: " << resultado.gbPorSegundo() << " GB/s" << endl;
 }
 
-// -----ACTIVIDADES SOSPECHOSAS-----
-// función recursiva para detectar actividades sospechosas
-void detectarSospechosasRecursivo(NodoCola* actual, map<string, map<string, int>>& patrones, time_t intervalo = 600) {
-    if (!actual) return; // caso base: si la cola está vacía o ya no hay más nodos, termina la recursión
-
-    patrones[actual->usuario][actual->actividad]++; // incrementa el contador de actividad para el usuario en el mapa
-    detectarSospechosasRecursivo(actual->siguiente, patrones); // llama recursivamente con el siguiente nodo
+// consulta accesos o actividades filtrando por usuario, perfil o actividad y horas recientes
+void consultarDatos(ListaEnlazadaAccesos& accesos, ColaActividades& cola) {
+    Consulta consulta;
+    string fuente, perfil, horas, agregacion;
+    cout << "Datos a consultar (1: accesos, 2: actividades): ";
+    cin.ignore();
+    getline(cin, fuente);
+    consulta.fuente = fuente == "2" ? FuenteConsulta::Actividades : FuenteConsulta::Accesos;
+    cout << "Usuario (vacio para todos): ";
+    getline(cin, consulta.usuario);
+    if (consulta.fuente == FuenteConsulta::Accesos) {
+        cout << "Perfil (0 para todos): ";
+        getline(cin, perfil);
+        consulta.perfil = atoi(perfil.c_str());
+    } else {
+        cout << "Actividad (vacio para todas): ";
+        getline(cin, consulta.actividad);
+    }
+    cout << "Ultimas horas a incluir (0 sin limite): ";
+    getline(cin, horas);
+    cout << "Resultado (1: listar, 2: contar, 3: por usuario, 4: por perfil o actividad): ";
+    getline(cin, agregacion);
+    int ultimasHoras = atoi(horas.c_str()), tipo = atoi(agregacion.c_str());
+    if ((fuente != "1" && fuente != "2") || ultimasHoras < 0 || tipo < 1 || tipo > 4) {
+        cout << "Error: Opcion de consulta no valida." << endl; // mensaje de error
+        return;
+    }
+
+    if (ultimasHoras > 0) consulta.desde = time(0) - static_cast<time_t>(ultimasHoras) * 3600;
+    const AgregacionConsulta tipos[] = {AgregacionConsulta::Listar, AgregacionConsulta::Contar, AgregacionConsulta::PorUsuario,
+                                        consulta.fuente == FuenteConsulta::Accesos ? AgregacionConsulta::PorPerfil : AgregacionConsulta::PorActividad};
+    consulta.agregacion = tipos[tipo - 1];
+    mostrarResultadoConsulta(consulta, ejecutarConsulta(consulta, accesos, cola));
 }
 
-// genera un informe de actividades sospechosas
-void generarInformeSospechosas(ColaActividades& cola) {
-    map<string, map<string, int>> patrones; // estructura para almacenar patrones de actividades por usuario
-    detectarSospechosasRecursivo(cola.getFrente(), patrones); // llena los patrones usando la función recursiva
-
-    cout << "Informe de actividades sospechosas:\n"; // mensaje inicial en consola
-    ofstream archivo("informe_sospechosas.txt"); // abre un archivo para guardar el informe
-    archivo << "Informe de Actividades Sospechosas:\n"; // escribe el encabezado en el archivo
-
-    // recorre los patrones para identificar actividades sospechosas
-    for (const auto& usuario : patrones) {
-        for (const auto& actividad : usuario.second) {
-            if (actividad.second > 2) { // si una actividad se repite más de dos veces, es sospechosa
-                cout << "Usuario: " << usuario.first << ", Actividad: " << actividad.first
-                     << ", Repeticiones: " << actividad.second << "\n"; // imprime los detalles en consola
-                archivo << "Usuario: " << usuario.first << ", Actividad: " << actividad.first
-                        << ", Repeticiones: " << actividad.second << "\n"; // guarda los detalles en el archivo
-            }
-        }
-    }
-    archivo.close(); // cierra el archivo después de guardar los datos
+// nivel de seguridad que exige cada opcion del menu del analista
+constexpr NivelSeguridad nivelOpcionAnalista(int opcion) {
+    if (opcion == 6 || opcion == 7) return NivelSeguridad::Alto; // exportar e informes escriben archivos con los datos
+    return opcion >= 1 && opcion <= 8 ? NivelSeguridad::Medio : NivelSeguridad::Bajo;
 }
 
-// -----MENU ANALISTA-----
-// menú interactivo para el analista
-void menuAnalista(ListaEnlazadaAccesos& accesos, ColaActividades& cola) {
+void menuAnalista(ListaEnlazadaAccesos& accesos, ColaActividades& cola, PilaSeguridad& pila) {
     int opcion; // variable para almacenar la opción del usuario
     do {
         cout << "\n=== Menu del Analista ===\n"; // encabezado del menú
         cout << "1. Generar estadisticas de accesos\n"; // opción para estadísticas
         cout << "2. Detectar actividades sospechosas\n"; // opción para detectar actividades
-        cout << "3. Salir\n"; // opción para salir
+        cout << "3. Ver latencias de inicio de sesion\n"; // opción para latencias
+        cout << "4. Ver metricas de la cola general\n"; // opción para la cola
+        cout << "5. Ver panel de accesos por periodo\n"; // opción para los acumulados
+        cout << "6. Exportar datos\n"; // opción para exportar
+        cout << "7. Informe desde el ultimo informe\n"; // opción para el informe incremental
+        cout << "8. Consultar accesos y actividades\n"; // opción para consultas ad hoc
+        cout << "9. Salir\n"; // opción para salir
         cout << "Selecciona una opcion: ";
         cin >> opcion; // lee la opción del usuario
 
+        ContextoSeguridad contexto(pila, nivelOpcionAnalista(opcion)); // apila el nivel de la peticion mientras se atiende
+        if (!contexto.permitido()) {
+            cout << "Error: Tu nivel de seguridad no permite esta opcion.\n"; // mensaje de error
+            continue;
+        }
         switch (opcion) {
             case 1:
                 generarEstadisticasAccesos(accesos); // llama a la función para generar estadísticas
                 break;
             case 2:
-                generarInformeSospechosas(cola); // llama a la función para generar el informe de sospechosas
+                generarInformeSospechosas(detectorSospechosas); // informe de la ventana actual del detector
                 break;
             case 3:
+                generarInformeLatencias(); // muestra y vuelca las latencias por fase
+                break;
+            case 4:
+                generarInformeCola(cola); // muestra y vuelca las metricas de la cola
+                break;
+            case 5:
+                generarPanelAccesos(accesos); // accesos por hora, dia y perfil
+                break;
+            case 6:
+                exportarDatos(accesos, cola); // exporta a CSV o columnar
+                break;
+            case 7:
+                generarInformeIncremental(accesos, cola); // procesa solo lo nuevo desde el ultimo informe
+                break;
+            case 8:
+                consultarDatos(accesos, cola); // filtra y agrega con el mejor indice disponible
+                break;
+            case 9:
                 cout << "Saliendo del menu del analista...\n"; // mensaje de salida
                 break;
             default:
                 cout << "Opcion no valida. Intentalo de nuevo.\n"; // mensaje de error si la opción es inválida
         }
-    } while (opcion != 3); // repite mientras el usuario no seleccione salir
+    } while (opcion != 9); // repite mientras el usuario no seleccione salir
+}
+
+// -----PLAZOS-----
+// cada cuanto se recuerda una actividad vencida que sigue pendiente
+constexpr time_t intervaloRecordatorio = 3600;
+
+// avisa de las actividades cuyo plazo vencio, en la cola general y en los seguimientos de
+// los supervisores, y programa su siguiente recordatorio
+void revisarPlazos(ColaActividades& colaGeneral) {
+    time_t ahora = time(0);
+    colaGeneral.procesarVencimientos(ahora, [ahora](const RegistroActividad& registro) {
+        cout << (registro.vencida ? "Recordatorio: sigue pendiente '" : "Aviso: vencio el plazo de '")
+             << registro.getActividad() << "' asignada a " << registro.getUsuario() << "." << endl;
+        return ahora + intervaloRecordatorio; // vuelve a avisar mientras siga pendiente
+    });
+    colasSupervisores.recorrer([&](const string& supervisor, ColaActividades& cola) {
+        cola.procesarVencimientos(ahora, [&](const RegistroActividad& registro) {
+            if (!colaGeneral.tieneActividad(registro.getUsuario(), registro.getActividad())) return time_t{0}; // ya completada
+            cout << (registro.vencida ? "Recordatorio para " : "Aviso para ") << supervisor << ": sigue sin completarse '"
+                 << registro.getActividad() << "' asignada a " << registro.getUsuario() << "." << endl;
+            return ahora + intervaloRecordatorio;
+        });
+    });
 }
 
 // -----INICIAR SESION-----
@@ -514,6 +350,7 @@ void iniciarSesion(ListaEnlazadaAccesos& accesos, ColaActividades& colaGeneral)
     string usuario, contrasena, telefono, contrasenaAleatoria; // variables para almacenar las credenciales
 
     cout << "\n*** Bienvenido al sistema de login ***\n"; // mensaje inicial
+    revisarPlazos(colaGeneral); // avisa de los plazos vencidos desde el ultimo inicio de sesion
     cout << "Contrasenia diaria: " << generarContrasenaDiaria() << endl; // muestra la contraseña diaria
 
     // solicita el nombre de usuario
@@ -521,70 +358,89 @@ void iniciarSesion(ListaEnlazadaAccesos& accesos, ColaActividades& colaGeneral)
     cin >> usuario;
 
     // busca el nodo del usuario en la lista
-    NodoAcceso* nodo = accesos.buscarPorNombre(usuario); // busca por nombre de usuario
+    NodoAcceso* nodo = medirFase(FaseLogin::Busqueda, [&] { return accesos.buscarPorNombre(usuario); }); // busca por nombre de usuario
     if (!nodo) { // si no encuentra el nodo
         cout << "Error: Usuario no encontrado." << endl; // mensaje de error
         return; // termina la función
     }
 
-    // lógica para perfil general (perfil == 1)
-    if (nodo->perfil == 1) {
-        cout << "Login exitoso. Bienvenido, " << nodo->nombreUsuario << "!\n"; // mensaje de bienvenida
-
-        // asigna automáticamente una actividad al usuario
-        asignarActividadAutomaticamente(accesos, colaGeneral, usuario);
-
-        // muestra las actividades asignadas al usuario
-        cout << "\nActividades asignadas a " << usuario << ":\n";
-        colaGeneral.mostrar(usuario);
+    const DescriptorPerfil* perfil = buscarPerfil(nodo->perfil); // descriptor del perfil del usuario
+    if (!perfil) { // caso para perfiles no reconocidos
+        cout << "Error: Perfil no reconocido." << endl; // mensaje de error si el perfil no es válido
+        return;
     }
-    // lógica para perfil supervisor (perfil == 2)
-    else if (nodo->perfil == 2) {
-        cout << "Ingrese su contrasenia: ";
-        cin >> contrasena;
 
-        if (nodo->contrasena == contrasena) { // verifica la contraseña
-            cout << "Login exitoso. Bienvenido, " << nodo->nombreUsuario << "!\n";
-
-            // crea una cola local para el supervisor
-            ColaActividades colaSupervisor;
-
-            // llama al menú del supervisor
-            menuSupervisor(accesos, &colaGeneral, &colaSupervisor, nodo->nombreUsuario);
-        } else {
-            cout << "Error: Contrasenia incorrecta." << endl; // mensaje de error si la contraseña no coincide
-        }
-    }
-    // lógica para perfil analista (perfil == 3)
-    else if (nodo->perfil == 3) {
+    // solicita solo los factores que exige el perfil
+    if (perfil->requiereContrasena) {
         cout << "Ingrese su contrasenia: ";
         cin >> contrasena;
+    }
+    if (perfil->requiereTelefono) {
         cout << "Ingrese su telefono: ";
         cin >> telefono;
+    }
+    if (perfil->requiereContrasenaDiaria) {
         cout << "Ingrese la contrasenia diaria: ";
         cin >> contrasenaAleatoria;
-
-        if (nodo->contrasena == contrasena && nodo->telefono == telefono &&
-            contrasenaAleatoria == generarContrasenaDiaria()) { // verifica todas las credenciales del analista
-            cout << "Login exitoso. Bienvenido, " << nodo->nombreUsuario << "!\n";
-
-            // llama al menú del analista
-            menuAnalista(accesos, colaGeneral);
-        } else {
-            cout << "Error: Credenciales incorrectas." << endl; // mensaje de error si las credenciales son inválidas
-        }
     }
-    // caso para perfiles no reconocidos
-    else {
-        cout << "Error: Perfil no reconocido." << endl; // mensaje de error si el perfil no es válido
+
+    bool valido = medirFase(FaseLogin::Credenciales, [&] {
+        return (!perfil->requiereContrasena | (nodo->contrasena == contrasena))
+               & (!perfil->requiereTelefono | (nodo->telefono == telefono));
+    });
+    valido &= medirFase(FaseLogin::ContrasenaDiaria, [&] {
+        return !perfil->requiereContrasenaDiaria || contrasenaAleatoria == generarContrasenaDiaria();
+    }); // verifica todos los factores
+    if (!valido) {
+        int factores = perfil->requiereContrasena + perfil->requiereTelefono + perfil->requiereContrasenaDiaria;
+        cout << (factores == 1 ? "Error: Contrasenia incorrecta." : "Error: Credenciales incorrectas.") << endl; // mensaje de error
+        return;
     }
+
+    cout << "Login exitoso. Bienvenido, " << nodo->nombreUsuario << "!\n"; // mensaje de bienvenida
+
+    PilaSeguridad pila; // pila de seguridad de esta sesion, sin reservar memoria
+    pila.ajustarNivel(nodo->perfil); // el nivel activo es el primero que declara el perfil
+    cout << "Nivel de seguridad de la sesion: " << nombreNivel(pila.peek()) << endl;
+    perfil->sesion(accesos, colaGeneral, nodo, usuario, pila); // continua con la sesion propia del perfil
+}
+
+// sesion del usuario general
+void PerfilUsuario::sesion(ListaEnlazadaAccesos& accesos, ColaActividades& colaGeneral, NodoAcceso* /*nodo*/, const string& usuario,
+                           PilaSeguridad& pila) {
+    ContextoSeguridad contexto(pila, NivelSeguridad::Bajo); // la consulta de actividades propias solo exige el nivel bajo
+    if (!contexto.permitido()) return;
+
+    // asigna automáticamente una actividad al usuario
+    medirFase(FaseLogin::AsignacionAutomatica, [&] { asignarActividadAutomaticamente(accesos, colaGeneral, usuario); });
+
+    // muestra las actividades asignadas al usuario
+    cout << "\nActividades asignadas a " << usuario << ":\n";
+    colaGeneral.mostrar(usuario);
+}
+
+// sesion del supervisor
+void PerfilSupervisor::sesion(ListaEnlazadaAccesos& accesos, ColaActividades& colaGeneral, NodoAcceso* nodo, const string& /*usuario*/,
+                              PilaSeguridad& pila) {
+    // cola propia del supervisor, que se conserva entre sesiones
+    ColaActividades& colaSupervisor = colasSupervisores.obtener(nodo->nombreUsuario);
+
+    // llama al menú del supervisor
+    menuSupervisor(accesos, &colaGeneral, &colaSupervisor, nodo->nombreUsuario, pila);
+}
+
+// sesion del analista
+void PerfilAnalista::sesion(ListaEnlazadaAccesos& accesos, ColaActividades& colaGeneral, NodoAcceso* /*nodo*/, const string& /*usuario*/,
+                            PilaSeguridad& pila) {
+    // llama al menú del analista
+    menuAnalista(accesos, colaGeneral, pila);
 }
 
 
 // -----PRUEBAS DEL SISTEMA-----
 // pruebas del sistema de login y control de seguridad
-void pruebas() {
-    unique_ptr<ListaEnlazadaAccesos> accesos = make_unique<ListaEnlazadaAccesos>(); // crea una lista enlazada de accesos
+void pruebas(ModoEstadisticas modo) {
+    unique_ptr<ListaEnlazadaAccesos> accesos = make_unique<ListaEnlazadaAccesos>(modo); // crea una lista enlazada de accesos
     unique_ptr<PilaSeguridad> pila = make_unique<PilaSeguridad>(); // crea una pila de seguridad
 
     // crea registros de usuarios con diferentes perfiles y horarios
@@ -596,6 +452,8 @@ void pruebas() {
     accesos->insertar("ana", haceUnaHora, 2, "password2"); // inserta un supervisor
     accesos->insertar("carlos", haceDosHoras, 3, "password3", "987654321"); // inserta un analista
 
+    cout << "Bytes por registro de acceso: " << sizeof(NodoAcceso) << endl; // tamaño de cada nodo
+
     // muestra los registros de accesos
     cout << "Lista de accesos registrados:" << endl;
     accesos->mostrar();
@@ -616,6 +474,10 @@ void pruebas() {
     cout << "\nAjustando nivel de seguridad para perfil 2:" << endl; // indica que ajustara la seguridad para el supervisor
     pila->ajustarNivel(2); // ajusta el nivel de seguridad para el perfil de supervisor
     pila->mostrarPila(); // muestra los niveles de seguridad en la pila
+    pila->push(NivelSeguridad::Alto); // eleva temporalmente el nivel de la sesion
+    cout << "Nivel activo tras elevarlo: " << nombreNivel(pila->peek()) << endl;
+    pila->pop(); // vuelve al nivel anterior
+    cout << "Nivel activo tras restaurarlo: " << nombreNivel(pila->peek()) << endl;
 
     // validacion de credenciales
     cout << "\nValidacion de credenciales:" << endl; // mensaje de inicio de la validacion
@@ -650,9 +512,44 @@ void pruebas() {
 }
 
 // -----FUNCION PRINCIPAL-----
-// funcion principal del programa
-int main() {
+// funcion principal del programa; si recibe una ruta, la cola general usa ese diario
+// para conservar las actividades pendientes entre ejecuciones
+int main(int argc, char* argv[]) {
     srand(time(0)); // inicializa el generador de numeros aleatorios con la hora actual
-    pruebas(); // ejecuta las pruebas del sistema
+    const char* rutaDiario = nullptr; // diario del modo durable, si se indica
+    LimiteCola limite; // sin limite salvo que se indique --capacidad
+    ModoEstadisticas modo = ModoEstadisticas::Exacto; // estadisticas de accesos
+    for (int i = 1; i < argc; ++i) {
+        string argumento = argv[i];
+        if (argumento == "--aproximado") {
+            modo = ModoEstadisticas::Aproximado;
+        } else if (argumento == "--capacidad" && i + 1 < argc) {
+            limite.capacidad = strtoull(argv[++i], nullptr, 10);
+        } else if (argumento == "--politica" && i + 1 < argc) {
+            string politica = argv[++i];
+            if (politica == "bloquear") limite.politica = PoliticaDesborde::Bloquear;
+            else if (politica == "rechazar") limite.politica = PoliticaDesborde::Rechazar;
+            else if (politica == "descartar") limite.politica = PoliticaDesborde::DescartarAntigua;
+            else cout << "Error: Politica desconocida " << politica << ", se usa rechazar." << endl;
+        } else {
+            rutaDiario = argv[i];
+        }
+    }
+    colaGeneral.limitar(limite);
+    detectorSospechosas.setAlAlertar([](const AlertaSospechosa& alerta) {
+        cout << "Alerta: " << alerta.getUsuario() << " recibio '" << alerta.getActividad() << "' "
+             << alerta.repeticiones << " veces en los ultimos " << detectorSospechosas.getIntervalo() / 60 << " minutos." << endl;
+    });
+    colaGeneral.vigilar(&detectorSospechosas); // analiza cada asignacion al encolarla
+    if (rutaDiario) {
+        ConfiguracionDiario configuracion;
+        configuracion.ruta = rutaDiario;
+        if (colaGeneral.activarDurabilidad(configuracion)) {
+            cout << "Modo durable activo: " << colaGeneral.tamano() << " actividades recuperadas." << endl;
+        } else {
+            cout << "Error: No se pudo abrir el diario " << rutaDiario << "; la cola no es durable." << endl;
+        }
+    }
+    pruebas(modo); // ejecuta las pruebas del sistema
     return 0; // finaliza la ejecucion del programa
 }
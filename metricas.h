@@ -0,0 +1,231 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define METRICAS_RELOJ_TSC 1
+#include <x86intrin.h>
+#endif
+using namespace std;
+
+// -----METRICAS DE LOGIN-----
+// histograma de latencias con cubetas log-lineales al estilo HDR: 16 subcubetas por
+// potencia de dos (error relativo < 6.25%); registrar es lock-free y sin reservas
+class HistogramaLatencia {
+public:
+    static constexpr int bitsSubcubeta = 4;
+    static constexpr int subcubetas = 1 << bitsSubcubeta;
+    static constexpr int grupos = 64 - bitsSubcubeta + 1; // cubre todo uint64_t
+
+private:
+    array<atomic<uint64_t>, grupos * subcubetas> cubetas{}; // conteo por cubeta
+    atomic<uint64_t> muestras{0}; // numero de valores registrados
+    atomic<uint64_t> suma{0}; // suma de los valores, para la media
+    atomic<uint64_t> maximo{0}; // mayor valor registrado
+
+    // cubeta que corresponde a un valor
+    static int indiceCubeta(uint64_t valor) {
+        if (valor < subcubetas) return static_cast<int>(valor); // grupo 0: valores exactos
+        int exponente = bit_width(valor) - 1;
+        int desplazamiento = exponente - bitsSubcubeta;
+        return (desplazamiento + 1) * subcubetas + static_cast<int>((valor >> desplazamiento) - subcubetas);
+    }
+
+    // valor representativo (punto medio) de una cubeta
+    static uint64_t valorCubeta(int indice) {
+        int grupo = indice / subcubetas;
+        uint64_t sub = indice % subcubetas;
+        if (grupo == 0) return sub;
+        uint64_t inferior = (subcubetas + sub) << (grupo - 1);
+        return inferior + ((uint64_t{1} << (grupo - 1)) >> 1);
+    }
+
+public:
+    // registra un valor (en nanosegundos)
+    void registrar(uint64_t valor) {
+        cubetas[indiceCubeta(valor)].fetch_add(1, memory_order_relaxed);
+        muestras.fetch_add(1, memory_order_relaxed);
+        suma.fetch_add(valor, memory_order_relaxed);
+        uint64_t actual = maximo.load(memory_order_relaxed);
+        while (valor > actual && !maximo.compare_exchange_weak(actual, valor, memory_order_relaxed)) {}
+    }
+
+    uint64_t getMuestras() const {
+        return muestras.load(memory_order_relaxed);
+    }
+
+    uint64_t getMaximo() const {
+        return maximo.load(memory_order_relaxed);
+    }
+
+    double media() const {
+        uint64_t n = getMuestras();
+        return n ? static_cast<double>(suma.load(memory_order_relaxed)) / n : 0.0;
+    }
+
+    // devuelve el valor del percentil indicado (0-100)
+    uint64_t percentil(double p) const {
+        uint64_t n = getMuestras();
+        if (n == 0) return 0;
+        uint64_t objetivo = static_cast<uint64_t>(p / 100.0 * n + 0.5);
+        if (objetivo == 0) objetivo = 1;
+        uint64_t acumulado = 0;
+        for (int i = 0; i < grupos * subcubetas; ++i) {
+            acumulado += cubetas[i].load(memory_order_relaxed);
+            if (acumulado >= objetivo) return min(valorCubeta(i), getMaximo());
+        }
+        return getMaximo();
+    }
+};
+
+// reloj de bajo coste para las metricas de login: el contador de ciclos en x86-64 (estable
+// en los procesadores actuales) y steady_clock en el resto. Las lecturas son ticks; se
+// convierten a nanosegundos solo al generar informes
+class RelojMetricas {
+public:
+    static uint64_t ticks() {
+#ifdef METRICAS_RELOJ_TSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // nanosegundos por tick; la primera llamada lo calibra contra steady_clock durante ~5 ms
+    static double nsPorTick() {
+#ifdef METRICAS_RELOJ_TSC
+        static const double factor = [] {
+            auto inicio = chrono::steady_clock::now();
+            uint64_t ticksInicio = ticks();
+            while (chrono::steady_clock::now() - inicio < chrono::milliseconds(5)) {}
+            uint64_t ticksFin = ticks();
+            double ns = static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count());
+            return ticksFin > ticksInicio ? ns / static_cast<double>(ticksFin - ticksInicio) : 1.0;
+        }();
+        return factor;
+#else
+        return 1.0;
+#endif
+    }
+};
+
+// fases del inicio de sesion que se miden
+enum class FaseLogin { Busqueda, Credenciales, ContrasenaDiaria, AsignacionAutomatica };
+
+// nombre de cada fase, indexado por FaseLogin
+constexpr array<const char*, 4> nombresFaseLogin = {"busqueda", "credenciales", "contrasena_diaria", "asignacion_automatica"};
+
+// histogramas de latencia por fase del inicio de sesion, en ticks de RelojMetricas. Solo
+// se cronometra una de cada intervaloMuestreo ejecuciones de cada fase (la primera
+// siempre); las demas solo se cuentan, de modo que la instrumentacion cuesta una fraccion
+// pequeña de fases que duran cientos de nanosegundos. Los percentiles son los de la muestra
+class MetricasLogin {
+public:
+    static constexpr uint32_t intervaloMuestreo = 8;
+
+private:
+    array<HistogramaLatencia, nombresFaseLogin.size()> fases;
+    // ejecuciones de cada fase; lectura y escritura relajadas sin RMW: con escritores
+    // concurrentes puede perderse alguna cuenta, lo que solo desplaza el muestreo
+    array<atomic<uint32_t>, nombresFaseLogin.size()> ejecuciones{};
+
+public:
+    // ejecuta una funcion y, si le toca muestra, registra su duracion en la fase indicada
+    template <typename Funcion>
+    decltype(auto) medir(FaseLogin fase, Funcion&& funcion) {
+        atomic<uint32_t>& contador = ejecuciones[static_cast<int>(fase)];
+        uint32_t n = contador.load(memory_order_relaxed);
+        contador.store(n + 1, memory_order_relaxed);
+        if (n % intervaloMuestreo) return funcion();
+        uint64_t inicio = RelojMetricas::ticks();
+        if constexpr (is_void_v<invoke_result_t<Funcion>>) {
+            funcion();
+            fases[static_cast<int>(fase)].registrar(RelojMetricas::ticks() - inicio);
+        } else {
+            decltype(auto) resultado = funcion();
+            fases[static_cast<int>(fase)].registrar(RelojMetricas::ticks() - inicio);
+            return resultado;
+        }
+    }
+
+    // histograma de la fase, en ticks
+    const HistogramaLatencia& getFase(FaseLogin fase) const {
+        return fases[static_cast<int>(fase)];
+    }
+
+    // veces que se ejecuto la fase, cronometradas o no
+    uint64_t getEjecuciones(FaseLogin fase) const {
+        return ejecuciones[static_cast<int>(fase)].load(memory_order_relaxed);
+    }
+
+    static uint64_t nanosegundos(uint64_t ticks) {
+        return static_cast<uint64_t>(static_cast<double>(ticks) * RelojMetricas::nsPorTick() + 0.5);
+    }
+};
+
+// metricas globales del inicio de sesion
+inline MetricasLogin metricasLogin;
+
+// ejecuta una funcion y registra su duracion en la fase indicada de metricasLogin
+template <typename Funcion>
+decltype(auto) medirFase(FaseLogin fase, Funcion&& funcion) {
+    return metricasLogin.medir(fase, std::forward<Funcion>(funcion));
+}
+
+// -----METRICAS DE LA COLA-----
+// contadores de una cola de actividades; se actualizan con el cerrojo de la cola tomado y
+// pueden leerse sin el, por lo que los informes no frenan a los productores
+class MetricasCola {
+private:
+    atomic<uint64_t> encoladas{0}; // actividades aceptadas
+    atomic<uint64_t> rechazadas{0}; // actividades rechazadas por falta de espacio
+    atomic<uint64_t> descartadas{0}; // actividades antiguas eliminadas para hacer sitio
+    atomic<uint64_t> profundidadMaxima{0}; // mayor numero de actividades en la cola
+    chrono::steady_clock::time_point creacion = chrono::steady_clock::now(); // inicio de la medicion
+    HistogramaLatencia bloqueos; // ns que los productores esperan por espacio
+    HistogramaLatencia permanencia; // s desde que se encola una actividad hasta que se extrae
+
+public:
+    void anotarEncolado(uint64_t profundidad) {
+        encoladas.fetch_add(1, memory_order_relaxed);
+        if (profundidad > profundidadMaxima.load(memory_order_relaxed)) profundidadMaxima.store(profundidad, memory_order_relaxed);
+    }
+
+    void anotarRechazo() {
+        rechazadas.fetch_add(1, memory_order_relaxed);
+    }
+
+    void anotarDescartes(uint64_t cantidad) {
+        descartadas.fetch_add(cantidad, memory_order_relaxed);
+    }
+
+    void registrarBloqueo(chrono::steady_clock::time_point inicio) {
+        auto duracion = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count();
+        bloqueos.registrar(static_cast<uint64_t>(duracion));
+    }
+
+    void registrarPermanencia(time_t segundos) {
+        permanencia.registrar(segundos > 0 ? static_cast<uint64_t>(segundos) : 0);
+    }
+
+    uint64_t getEncoladas() const { return encoladas.load(memory_order_relaxed); }
+    uint64_t getRechazadas() const { return rechazadas.load(memory_order_relaxed); }
+    uint64_t getDescartadas() const { return descartadas.load(memory_order_relaxed); }
+    uint64_t getProfundidadMaxima() const { return profundidadMaxima.load(memory_order_relaxed); }
+    const HistogramaLatencia& getBloqueos() const { return bloqueos; }
+    const HistogramaLatencia& getPermanencia() const { return permanencia; }
+
+    // actividades aceptadas por segundo desde que se creo la cola
+    double tasaEncolado() const {
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - creacion).count();
+        return segundos > 0 ? getEncoladas() / segundos : 0.0;
+    }
+};
+
+#endif //METRICAS_H
@@ -0,0 +1,106 @@
+#ifndef PERFILES_H
+#define PERFILES_H
+
+#include <array>
+#include <string>
+using namespace std;
+
+// -----NIVELES DE SEGURIDAD-----
+// niveles de seguridad conocidos en tiempo de compilacion
+enum class NivelSeguridad : unsigned char { Bajo, Medio, Alto };
+
+// nombre de cada nivel, indexado por NivelSeguridad
+constexpr array<const char*, 3> nombresNivelSeguridad = {"Bajo", "Medio", "Alto"};
+
+// devuelve el nombre de un nivel sin reservar memoria
+constexpr const char* nombreNivel(NivelSeguridad nivel) {
+    return nombresNivelSeguridad[static_cast<int>(nivel)];
+}
+
+// -----PERFILES-----
+class NodoAcceso;
+class ListaEnlazadaAccesos;
+class ColaActividades;
+class PilaSeguridad;
+
+// funcion que atiende la sesion de un perfil una vez validadas sus credenciales; recibe la
+// pila de seguridad de la sesion, ajustada al orden del perfil
+using SesionPerfil = void (*)(ListaEnlazadaAccesos&, ColaActividades&, NodoAcceso*, const string&, PilaSeguridad&);
+
+// cada perfil es un tipo que declara en tiempo de compilacion sus factores y permisos;
+// para añadir un perfil basta con definir su tipo y registrarlo en tablaPerfiles
+struct PerfilUsuario {
+    static constexpr int id = 1; // identificador guardado en NodoAcceso::perfil
+    static constexpr const char* nombre = "Usuario";
+    static constexpr bool requiereContrasena = false; // factor: contraseña
+    static constexpr bool requiereTelefono = false; // factor: teléfono
+    static constexpr bool requiereContrasenaDiaria = false; // factor: contraseña diaria
+    static constexpr bool recibeActividades = true; // un supervisor puede asignarle actividades
+    static constexpr bool actividadesRevisables = true; // sus actividades pueden revisarse
+    static constexpr array<NivelSeguridad, 3> ordenSeguridad = {NivelSeguridad::Bajo, NivelSeguridad::Medio, NivelSeguridad::Alto}; // el primero es el nivel activo
+    static void sesion(ListaEnlazadaAccesos& accesos, ColaActividades& colaGeneral, NodoAcceso* nodo, const string& usuario, PilaSeguridad& pila);
+};
+
+struct PerfilSupervisor {
+    static constexpr int id = 2;
+    static constexpr const char* nombre = "Supervisor";
+    static constexpr bool requiereContrasena = true;
+    static constexpr bool requiereTelefono = false;
+    static constexpr bool requiereContrasenaDiaria = false;
+    static constexpr bool recibeActividades = true;
+    static constexpr bool actividadesRevisables = false;
+    static constexpr array<NivelSeguridad, 3> ordenSeguridad = {NivelSeguridad::Medio, NivelSeguridad::Bajo, NivelSeguridad::Alto}; // el primero es el nivel activo
+    static void sesion(ListaEnlazadaAccesos& accesos, ColaActividades& colaGeneral, NodoAcceso* nodo, const string& usuario, PilaSeguridad& pila);
+};
+
+struct PerfilAnalista {
+    static constexpr int id = 3;
+    static constexpr const char* nombre = "Analista";
+    static constexpr bool requiereContrasena = true;
+    static constexpr bool requiereTelefono = true;
+    static constexpr bool requiereContrasenaDiaria = true;
+    static constexpr bool recibeActividades = false;
+    static constexpr bool actividadesRevisables = false;
+    static constexpr array<NivelSeguridad, 3> ordenSeguridad = {NivelSeguridad::Alto, NivelSeguridad::Medio, NivelSeguridad::Bajo}; // el primero es el nivel activo
+    static void sesion(ListaEnlazadaAccesos& accesos, ColaActividades& colaGeneral, NodoAcceso* nodo, const string& usuario, PilaSeguridad& pila);
+};
+
+// descripcion de un perfil en tiempo de ejecucion, generada a partir de su tipo
+struct DescriptorPerfil {
+    const char* nombre = nullptr; // nullptr indica un perfil no registrado
+    bool requiereContrasena = false;
+    bool requiereTelefono = false;
+    bool requiereContrasenaDiaria = false;
+    bool recibeActividades = false;
+    bool actividadesRevisables = false;
+    array<NivelSeguridad, 3> ordenSeguridad = {NivelSeguridad::Bajo, NivelSeguridad::Medio, NivelSeguridad::Alto};
+    SesionPerfil sesion = nullptr;
+};
+
+// genera el descriptor de un perfil a partir de su tipo
+template <typename Perfil>
+constexpr DescriptorPerfil describirPerfil() {
+    return {Perfil::nombre, Perfil::requiereContrasena, Perfil::requiereTelefono, Perfil::requiereContrasenaDiaria,
+            Perfil::recibeActividades, Perfil::actividadesRevisables, Perfil::ordenSeguridad, &Perfil::sesion};
+}
+
+// construye la tabla de perfiles indexada por id (la posicion 0 queda sin registrar)
+template <typename... Perfiles>
+constexpr array<DescriptorPerfil, sizeof...(Perfiles) + 1> construirTablaPerfiles() {
+    static_assert(((Perfiles::id >= 1 && Perfiles::id <= static_cast<int>(sizeof...(Perfiles))) && ...),
+                  "los ids de perfil deben ser consecutivos desde 1");
+    array<DescriptorPerfil, sizeof...(Perfiles) + 1> tabla{};
+    ((tabla[Perfiles::id] = describirPerfil<Perfiles>()), ...); // cada perfil ocupa la posicion de su id
+    return tabla;
+}
+
+// tabla de perfiles registrados
+constexpr auto tablaPerfiles = construirTablaPerfiles<PerfilUsuario, PerfilSupervisor, PerfilAnalista>();
+
+// devuelve el descriptor de un perfil o nullptr si no esta registrado
+constexpr const DescriptorPerfil* buscarPerfil(int perfil) {
+    if (perfil < 1 || perfil >= static_cast<int>(tablaPerfiles.size())) return nullptr;
+    return &tablaPerfiles[perfil];
+}
+
+#endif //PERFILES_H
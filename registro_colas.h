@@ -0,0 +1,75 @@
+#ifndef REGISTRO_COLAS_H
+#define REGISTRO_COLAS_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "accesos.h"
+#include "actividades.h"
+#include "internado.h"
+using namespace std;
+
+// -----REGISTRO DE COLAS-----
+// guarda una cola de actividades propia por usuario, indexada por su id interno, que
+// sobrevive entre sesiones. El registro se reparte en fragmentos con su propio cerrojo
+// para que los accesos de usuarios distintos no compitan; cada cola tiene ademas el suyo
+class RegistroColas {
+    static constexpr size_t numFragmentos = 16; // potencia de dos
+
+    struct alignas(64) Fragmento { // alineado para que los cerrojos no compartan linea de cache
+        mutex cerrojo; // protege colas
+        unordered_map<uint32_t, unique_ptr<ColaActividades>> colas; // cola de cada id de usuario
+    };
+
+    array<Fragmento, numFragmentos> fragmentos;
+
+    Fragmento& fragmento(uint32_t idUsuario) {
+        return fragmentos[idUsuario & (numFragmentos - 1)];
+    }
+
+public:
+    // devuelve la cola del usuario, creandola la primera vez; la referencia es estable
+    ColaActividades& obtener(const string& usuario) {
+        uint32_t idUsuario = tablaUsuarios.internar(toLowerCase(usuario));
+        Fragmento& destino = fragmento(idUsuario);
+        lock_guard bloqueo(destino.cerrojo);
+        unique_ptr<ColaActividades>& cola = destino.colas[idUsuario];
+        if (!cola) cola = make_unique<ColaActividades>();
+        return *cola;
+    }
+
+    // devuelve la cola del usuario o nullptr si aun no tiene
+    ColaActividades* buscar(const string& usuario) {
+        uint32_t idUsuario = tablaUsuarios.buscar(toLowerCase(usuario));
+        if (idUsuario == TablaInternado::sinId) return nullptr;
+        Fragmento& origen = fragmento(idUsuario);
+        lock_guard bloqueo(origen.cerrojo);
+        auto encontrada = origen.colas.find(idUsuario);
+        return encontrada == origen.colas.end() ? nullptr : encontrada->second.get();
+    }
+
+    // llama a visitar(usuario, cola) para cada cola registrada con el cerrojo de su
+    // fragmento tomado; visitar no debe usar el registro
+    template <typename Visitar>
+    void recorrer(Visitar visitar) {
+        for (Fragmento& f : fragmentos) {
+            lock_guard bloqueo(f.cerrojo);
+            for (auto& [idUsuario, cola] : f.colas) visitar(tablaUsuarios.valor(idUsuario), *cola);
+        }
+    }
+
+    // numero de colas registradas
+    size_t size() {
+        size_t total = 0;
+        for (Fragmento& f : fragmentos) {
+            lock_guard bloqueo(f.cerrojo);
+            total += f.colas.size();
+        }
+        return total;
+    }
+};
+
+#endif // REGISTRO_COLAS_H
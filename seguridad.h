@@ -0,0 +1,111 @@
+#ifndef SEGURIDAD_H
+#define SEGURIDAD_H
+
+#include <iostream>
+#include <string>
+#include <ctime>
+#include <cstdlib>
+#include "perfiles.h"
+using namespace std;
+
+// -----GESTION DE SEGURIDAD-----
+// clase para gestionar la pila de seguridad de una sesion; almacena los niveles
+// en un arreglo fijo, por lo que ninguna operacion reserva memoria
+class PilaSeguridad {
+public:
+    static constexpr int capacidad = 8; // niveles que caben en la pila
+
+private:
+    array<NivelSeguridad, capacidad> niveles{}; // niveles apilados, la cima es niveles[tamano - 1]
+    int tamano = 0; // numero de niveles apilados
+
+public:
+    // apila un nivel; devuelve false si la pila esta llena
+    bool push(NivelSeguridad nivel) {
+        if (tamano == capacidad) return false;
+        niveles[tamano++] = nivel;
+        return true;
+    }
+
+    // desapila el nivel de la cima; devuelve false si la pila esta vacia
+    bool pop() {
+        if (tamano == 0) return false;
+        --tamano;
+        return true;
+    }
+
+    // devuelve el nivel de la cima (nivel activo de la sesion); la pila no debe estar vacia
+    NivelSeguridad peek() const {
+        return niveles[tamano - 1];
+    }
+
+    bool vacia() const {
+        return tamano == 0;
+    }
+
+    int getTamano() const {
+        return tamano;
+    }
+
+    // reinicia la pila con el orden declarado por el perfil, dejando su primer nivel en la cima
+    void ajustarNivel(int perfil) {
+        const DescriptorPerfil* descriptor = buscarPerfil(perfil);
+        if (!descriptor) return; // perfil no registrado, mantiene los niveles actuales
+        const auto& orden = descriptor->ordenSeguridad;
+        tamano = static_cast<int>(orden.size());
+        for (int i = 0; i < tamano; ++i) {
+            niveles[i] = orden[tamano - 1 - i];
+        }
+    }
+
+    // muestra los niveles de seguridad en la pila, desde la cima
+    void mostrarPila() const {
+        cout << "Niveles de seguridad en la pila:" << endl; // encabezado
+        for (int i = tamano - 1; i >= 0; --i) { // recorre los niveles
+            cout << nombreNivel(niveles[i]) << endl; // muestra cada nivel
+        }
+    }
+};
+
+// contexto de seguridad de una peticion: si el nivel activo de la sesion alcanza el que
+// exige la peticion, apila ese nivel mientras dura y lo desapila al terminar
+class ContextoSeguridad {
+private:
+    PilaSeguridad& pila; // pila de la sesion que atiende la peticion
+    bool apilado; // true si la peticion esta autorizada y su nivel esta en la cima
+
+public:
+    ContextoSeguridad(PilaSeguridad& pila, NivelSeguridad requerido) : pila(pila) {
+        apilado = !pila.vacia() && pila.peek() >= requerido && pila.push(requerido);
+    }
+
+    ContextoSeguridad(const ContextoSeguridad&) = delete;
+    ContextoSeguridad& operator=(const ContextoSeguridad&) = delete;
+
+    ~ContextoSeguridad() {
+        if (apilado) pila.pop(); // restaura el nivel de la sesion
+    }
+
+    bool permitido() const {
+        return apilado;
+    }
+};
+
+// genera una contraseña diaria basada en la fecha
+inline string generarContrasenaDiaria() {
+    time_t ahora = time(0); // obtiene la hora actual
+    tm* tiempoLocal = localtime(&ahora); // convierte la hora a tiempo local
+
+    // usa el dia, mes y año como semilla para generar una contraseña
+    int semilla = tiempoLocal->tm_year * 10000 + (tiempoLocal->tm_mon + 1) * 100 + tiempoLocal->tm_mday;
+    srand(semilla); // establece la semilla
+
+    const string caracteres = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"; // caracteres posibles para la contraseña
+    string contrasena;
+    for (int i = 0; i < 8; ++i) {
+        contrasena += caracteres[rand() % caracteres.size()]; // selecciona caracteres aleatorios
+    }
+    return contrasena; // devuelve la contraseña generada
+}
+
+#endif //SEGURIDAD_H
@@ -0,0 +1,159 @@
+#ifndef TABLA_HASH_H
+#define TABLA_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// -----TABLA HASH PLANA-----
+// tabla hash de direccionamiento abierto con sondeo lineal: claves y valores viven en un
+// solo vector, sin un nodo por clave, y una busqueda recorre posiciones contiguas. Cada
+// ranura guarda ademas 7 bits del hash, que descartan casi todas las claves distintas sin
+// compararlas. La capacidad es potencia de dos y la carga no pasa de 3/4. Borrar desplaza
+// hacia atras los elementos siguientes, asi que no quedan marcas de borrado. Insertar o
+// borrar invalida los punteros a valores
+template <typename Clave, typename Valor, typename Hash = hash<Clave>>
+class TablaHashPlana {
+private:
+    struct Ranura {
+        Clave clave{};
+        Valor valor{};
+        uint8_t etiqueta = 0; // 0 si la ranura esta libre; si no, 0x80 mas 7 bits del hash
+    };
+
+    vector<Ranura> ranuras; // claves, valores y etiquetas
+    size_t cantidad = 0; // elementos en la tabla
+    size_t mascara = 0; // capacidad - 1
+
+    // mezcla el hash para que los bits bajos dependan de todos (std::hash de enteros es la identidad)
+    static size_t mezclar(size_t hash) {
+        uint64_t x = static_cast<uint64_t>(hash) * 0x9e3779b97f4a7c15ULL;
+        return static_cast<size_t>(x ^ (x >> 32));
+    }
+
+    static uint8_t etiqueta(size_t hash) {
+        return static_cast<uint8_t>(0x80 | (hash >> (sizeof(size_t) * 8 - 7)));
+    }
+
+    size_t inicial(const Clave& clave) const {
+        return mezclar(Hash{}(clave)) & mascara;
+    }
+
+    // posicion de la clave, o de la ranura libre donde iria
+    size_t posicion(const Clave& clave, size_t hash) const {
+        uint8_t buscada = etiqueta(hash);
+        size_t i = hash & mascara;
+        while (ranuras[i].etiqueta && !(ranuras[i].etiqueta == buscada && ranuras[i].clave == clave)) i = (i + 1) & mascara;
+        return i;
+    }
+
+    size_t posicion(const Clave& clave) const {
+        return posicion(clave, mezclar(Hash{}(clave)));
+    }
+
+    void redimensionar(size_t capacidad) {
+        vector<Ranura> anteriores(capacidad);
+        anteriores.swap(ranuras);
+        mascara = capacidad - 1;
+        for (Ranura& ranura : anteriores) {
+            if (ranura.etiqueta) ranuras[posicion(ranura.clave)] = std::move(ranura);
+        }
+    }
+
+public:
+    TablaHashPlana() {
+        redimensionar(16);
+    }
+
+    // prepara sitio para n elementos sin redimensionar
+    void reservar(size_t n) {
+        size_t capacidad = ranuras.size();
+        while (n * 4 > capacidad * 3) capacidad *= 2;
+        if (capacidad != ranuras.size()) redimensionar(capacidad);
+    }
+
+    // valor de la clave, insertandola con el valor por defecto si no existe
+    Valor& operator[](const Clave& clave) {
+        size_t hash = mezclar(Hash{}(clave));
+        size_t i = posicion(clave, hash);
+        if (ranuras[i].etiqueta) return ranuras[i].valor;
+        if ((cantidad + 1) * 4 > ranuras.size() * 3) { // mantiene la carga por debajo de 3/4
+            redimensionar(ranuras.size() * 2);
+            i = posicion(clave, hash);
+        }
+        ranuras[i].clave = clave;
+        ranuras[i].etiqueta = etiqueta(hash);
+        ++cantidad;
+        return ranuras[i].valor;
+    }
+
+    // valor de la clave o nullptr si no existe
+    Valor* buscar(const Clave& clave) {
+        size_t i = posicion(clave);
+        return ranuras[i].etiqueta ? &ranuras[i].valor : nullptr;
+    }
+
+    const Valor* buscar(const Clave& clave) const {
+        size_t i = posicion(clave);
+        return ranuras[i].etiqueta ? &ranuras[i].valor : nullptr;
+    }
+
+    bool contiene(const Clave& clave) const {
+        return ranuras[posicion(clave)].etiqueta != 0;
+    }
+
+    // elimina la clave; devuelve false si no existia
+    bool borrar(const Clave& clave) {
+        size_t i = posicion(clave);
+        if (!ranuras[i].etiqueta) return false;
+        // desplaza hacia el hueco los elementos cuya posicion inicial no queda entre el hueco y ellos
+        for (size_t j = (i + 1) & mascara; ranuras[j].etiqueta; j = (j + 1) & mascara) {
+            size_t k = inicial(ranuras[j].clave);
+            bool alcanzable = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+            if (alcanzable) continue; // sigue encontrandose desde su posicion inicial
+            ranuras[i] = std::move(ranuras[j]);
+            i = j;
+        }
+        ranuras[i] = Ranura{};
+        --cantidad;
+        return true;
+    }
+
+    // vacia la tabla conservando su capacidad
+    void limpiar() {
+        if (!cantidad) return;
+        for (Ranura& ranura : ranuras) {
+            if (ranura.etiqueta) ranura = Ranura{};
+        }
+        cantidad = 0;
+    }
+
+    size_t size() const {
+        return cantidad;
+    }
+
+    bool empty() const {
+        return cantidad == 0;
+    }
+
+    // llama a visitar(clave, valor) para cada elemento, sin orden definido; visitar no
+    // debe insertar ni borrar
+    template <typename Visitar>
+    void recorrer(Visitar visitar) const {
+        for (auto& ranura : ranuras) {
+            if (ranura.etiqueta) visitar(ranura.clave, ranura.valor);
+        }
+    }
+
+    template <typename Visitar>
+    void recorrer(Visitar visitar) {
+        for (auto& ranura : ranuras) {
+            if (ranura.etiqueta) visitar(ranura.clave, ranura.valor);
+        }
+    }
+};
+
+#endif // TABLA_HASH_H
@@ -0,0 +1,169 @@
+#ifndef TEMPORIZADORES_H
+#define TEMPORIZADORES_H
+
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+using namespace std;
+
+// -----RUEDA DE TEMPORIZADORES-----
+// rueda jerarquica de temporizadores con resolucion de un segundo: 4 niveles de 64
+// ranuras cubren unos 194 dias; los vencimientos mas lejanos se guardan en el ultimo
+// nivel y se recolocan al bajar. Programar y cancelar son O(1) y cada tick cuesta O(1)
+// mas los temporizadores que vencen o bajan de nivel en el
+class RuedaTemporizadores {
+public:
+    static constexpr uint32_t sinTemporizador = UINT32_MAX; // manejador nulo
+
+private:
+    static constexpr int bitsRanura = 6;
+    static constexpr int ranurasPorNivel = 1 << bitsRanura;
+    static constexpr int niveles = 4;
+
+    // temporizador programado; se enlaza en una lista doble dentro de su ranura
+    struct Entrada {
+        time_t vencimiento; // momento en que vence
+        uint64_t dato; // valor que identifica al temporizador para quien lo programo
+        uint32_t anterior; // entrada anterior de la ranura
+        uint32_t siguiente; // entrada siguiente de la ranura (o siguiente libre)
+        uint32_t ranura; // ranura en la que esta enlazada
+    };
+
+    vector<Entrada> entradas; // almacen de entradas, reutilizadas mediante la lista de libres
+    uint32_t libres = sinTemporizador; // primera entrada libre
+    array<uint32_t, niveles * ranurasPorNivel> ranuras; // primera entrada de cada ranura
+    time_t actual = 0; // ultimo segundo procesado
+    size_t activos = 0; // temporizadores programados
+
+    // ranura que corresponde a un vencimiento segun su distancia al segundo actual
+    int calcularRanura(time_t vencimiento) const {
+        if (vencimiento <= actual) vencimiento = actual + 1; // los vencidos saltan en el proximo tick
+        uint64_t distancia = static_cast<uint64_t>(vencimiento - actual);
+        for (int nivel = 0; nivel < niveles; ++nivel) {
+            if (distancia < (uint64_t{1} << (bitsRanura * (nivel + 1))) || nivel == niveles - 1) {
+                uint64_t indice = static_cast<uint64_t>(vencimiento) >> (bitsRanura * nivel);
+                if (nivel == niveles - 1 && distancia >= (uint64_t{1} << (bitsRanura * niveles))) {
+                    indice = (static_cast<uint64_t>(actual) >> (bitsRanura * nivel)) - 1; // fuera de rango: ultima ranura
+                }
+                return nivel * ranurasPorNivel + static_cast<int>(indice & (ranurasPorNivel - 1));
+            }
+        }
+        return 0;
+    }
+
+    void enlazar(uint32_t id) {
+        Entrada& e = entradas[id];
+        e.ranura = static_cast<uint32_t>(calcularRanura(e.vencimiento));
+        e.anterior = sinTemporizador;
+        e.siguiente = ranuras[e.ranura];
+        if (e.siguiente != sinTemporizador) entradas[e.siguiente].anterior = id;
+        ranuras[e.ranura] = id;
+    }
+
+    void desenlazar(uint32_t id) {
+        Entrada& e = entradas[id];
+        if (e.anterior != sinTemporizador) entradas[e.anterior].siguiente = e.siguiente;
+        else ranuras[e.ranura] = e.siguiente;
+        if (e.siguiente != sinTemporizador) entradas[e.siguiente].anterior = e.anterior;
+    }
+
+    void liberar(uint32_t id) {
+        entradas[id].siguiente = libres;
+        libres = id;
+        --activos;
+    }
+
+    // recoloca las entradas de una ranura de nivel superior en niveles inferiores
+    void bajarNivel(int ranura) {
+        uint32_t id = ranuras[ranura];
+        ranuras[ranura] = sinTemporizador;
+        while (id != sinTemporizador) {
+            uint32_t siguiente = entradas[id].siguiente;
+            enlazar(id);
+            id = siguiente;
+        }
+    }
+
+public:
+    RuedaTemporizadores() {
+        ranuras.fill(sinTemporizador);
+    }
+
+    // programa un temporizador; ahora fija el reloj de la rueda la primera vez
+    uint32_t programar(time_t vencimiento, uint64_t dato, time_t ahora) {
+        if (activos == 0 && ahora > actual) actual = ahora; // rueda vacia: se sincroniza con el reloj
+        uint32_t id;
+        if (libres != sinTemporizador) {
+            id = libres;
+            libres = entradas[id].siguiente;
+        } else {
+            id = static_cast<uint32_t>(entradas.size());
+            entradas.push_back({});
+        }
+        entradas[id].vencimiento = vencimiento;
+        entradas[id].dato = dato;
+        enlazar(id);
+        ++activos;
+        return id;
+    }
+
+    // cancela un temporizador programado
+    void cancelar(uint32_t id) {
+        desenlazar(id);
+        liberar(id);
+    }
+
+    // vencimiento de un temporizador programado
+    time_t vencimiento(uint32_t id) const {
+        return entradas[id].vencimiento;
+    }
+
+    size_t getActivos() const {
+        return activos;
+    }
+
+    // avanza el reloj hasta ahora llamando a alVencer(id, dato) por cada temporizador
+    // vencido; si devuelve un instante, el mismo temporizador se reprograma para
+    // entonces, y si devuelve 0 se libera. alVencer no debe programar ni cancelar
+    template <typename AlVencer>
+    size_t avanzar(time_t ahora, AlVencer alVencer) {
+        size_t vencidos = 0;
+        while (actual < ahora) {
+            if (activos == 0) { // nada programado: salta directamente al final
+                actual = ahora;
+                break;
+            }
+            ++actual;
+            // al completar una vuelta de un nivel baja la ranura correspondiente del siguiente
+            for (int nivel = 1; nivel < niveles; ++nivel) {
+                if ((static_cast<uint64_t>(actual) & ((uint64_t{1} << (bitsRanura * nivel)) - 1)) != 0) break;
+                uint64_t indice = (static_cast<uint64_t>(actual) >> (bitsRanura * nivel)) & (ranurasPorNivel - 1);
+                bajarNivel(nivel * ranurasPorNivel + static_cast<int>(indice));
+            }
+
+            int ranura = static_cast<int>(static_cast<uint64_t>(actual) & (ranurasPorNivel - 1));
+            uint32_t id = ranuras[ranura];
+            ranuras[ranura] = sinTemporizador;
+            while (id != sinTemporizador) {
+                uint32_t siguiente = entradas[id].siguiente;
+                if (entradas[id].vencimiento > actual) { // aun no vence (recolocado desde arriba)
+                    enlazar(id);
+                } else {
+                    ++vencidos;
+                    time_t nuevo = alVencer(id, entradas[id].dato);
+                    if (nuevo != 0) {
+                        entradas[id].vencimiento = nuevo;
+                        enlazar(id);
+                    } else {
+                        liberar(id);
+                    }
+                }
+                id = siguiente;
+            }
+        }
+        return vencidos;
+    }
+};
+
+#endif //TEMPORIZADORES_H